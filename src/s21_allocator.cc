@@ -0,0 +1,171 @@
+#include "s21_allocator.h"
+
+#include <new>
+#include <utility>
+
+namespace {
+
+constexpr std::size_t kAlignment = 64;
+
+double* AlignedNew(std::size_t bytes) {
+  return static_cast<double*>(
+      ::operator new(bytes, std::align_val_t{kAlignment}));
+}
+
+void AlignedDelete(double* buffer) noexcept {
+  ::operator delete(buffer, std::align_val_t{kAlignment});
+}
+
+class HeapAllocator final : public S21MatrixAllocator {
+ public:
+  double* Allocate(std::size_t count) override {
+    return AlignedNew(sizeof(double) * count);
+  }
+  void Deallocate(double* buffer, std::size_t) noexcept override {
+    AlignedDelete(buffer);
+  }
+};
+
+// nullptr stands for the heap allocator.
+std::atomic<S21MatrixAllocator*> current_allocator{nullptr};
+
+}  // namespace
+
+S21MatrixAllocator& S21HeapAllocator() noexcept {
+  static HeapAllocator allocator;
+  return allocator;
+}
+
+void S21SetMatrixAllocator(S21MatrixAllocator* allocator) noexcept {
+  current_allocator.store(allocator);
+}
+
+S21MatrixAllocator& S21GetMatrixAllocator() noexcept {
+  S21MatrixAllocator* allocator = current_allocator.load();
+  return allocator ? *allocator : S21HeapAllocator();
+}
+
+S21BufferPool& S21BufferPool::Instance() {
+  static S21BufferPool* pool = new S21BufferPool;
+  return *pool;
+}
+
+double* S21BufferPool::Allocate(std::size_t count) {
+  const int size_class = SizeClass(count);
+  double* result = nullptr;
+  if (size_class >= 0) {
+    const std::size_t bytes = ClassBytes(size_class);
+    result = Pop(&LocalCache().lists[size_class], bytes);
+    if (!result) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      result = Pop(&overflow_[size_class], bytes);
+    }
+    if (result) {
+      bytes_retained_.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+  }
+  if (result) {
+    hits_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    result = AlignedNew(size_class >= 0 ? ClassBytes(size_class)
+                                        : sizeof(double) * count);
+  }
+  return result;
+}
+
+void S21BufferPool::Deallocate(double* buffer, std::size_t count) noexcept {
+  const int size_class = SizeClass(count);
+  if (size_class < 0) {
+    AlignedDelete(buffer);
+  } else {
+    const std::size_t bytes = ClassBytes(size_class);
+    FreeList* list = &LocalCache().lists[size_class];
+    Push(list, buffer, bytes);
+    bytes_retained_.fetch_add(bytes, std::memory_order_relaxed);
+    if (list->bytes > kThreadCacheBytes) {
+      Spill(size_class, list, list->bytes / bytes / 2);
+    }
+  }
+}
+
+S21PoolStats S21BufferPool::Stats() const noexcept {
+  return {hits_.load(std::memory_order_relaxed),
+          misses_.load(std::memory_order_relaxed),
+          bytes_retained_.load(std::memory_order_relaxed)};
+}
+
+void S21BufferPool::Trim() noexcept {
+  ThreadCache& cache = LocalCache();
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (int c = 0; c < kClasses; ++c) {
+    Drain(&cache.lists[c]);
+    Drain(&overflow_[c]);
+  }
+}
+
+S21BufferPool::ThreadCache::~ThreadCache() {
+  for (int c = 0; c < kClasses; ++c) {
+    Instance().Spill(c, &lists[c], 0);
+  }
+}
+
+S21BufferPool::ThreadCache& S21BufferPool::LocalCache() noexcept {
+  thread_local ThreadCache cache;
+  return cache;
+}
+
+// Smallest class that holds count doubles, or -1 if none does.
+int S21BufferPool::SizeClass(std::size_t count) noexcept {
+  int size_class = 0;
+  while (size_class < kClasses &&
+         (std::size_t{1} << (kMinClassLog + size_class)) < count) {
+    ++size_class;
+  }
+  return size_class < kClasses ? size_class : -1;
+}
+
+std::size_t S21BufferPool::ClassBytes(int size_class) noexcept {
+  return sizeof(double) << (kMinClassLog + size_class);
+}
+
+double* S21BufferPool::Pop(FreeList* list, std::size_t bytes) noexcept {
+  double* result = list->head;
+  if (result) {
+    list->head = *reinterpret_cast<double**>(result);
+    list->bytes -= bytes;
+  }
+  return result;
+}
+
+void S21BufferPool::Push(FreeList* list, double* buffer,
+                         std::size_t bytes) noexcept {
+  *reinterpret_cast<double**>(buffer) = list->head;
+  list->head = buffer;
+  list->bytes += bytes;
+}
+
+// Moves all but the first keep buffers of a thread's list to the overflow.
+void S21BufferPool::Spill(int size_class, FreeList* list,
+                          std::size_t keep) noexcept {
+  const std::size_t bytes = ClassBytes(size_class);
+  FreeList spilled;
+  for (std::size_t i = 0; i < keep && list->head; ++i) {
+    Push(&spilled, Pop(list, bytes), bytes);
+  }
+  std::swap(spilled, *list);
+  std::lock_guard<std::mutex> lock(mutex_);
+  while (spilled.head) {
+    Push(&overflow_[size_class], Pop(&spilled, bytes), bytes);
+  }
+}
+
+void S21BufferPool::Drain(FreeList* list) noexcept {
+  bytes_retained_.fetch_sub(list->bytes, std::memory_order_relaxed);
+  while (list->head) {
+    double* buffer = list->head;
+    list->head = *reinterpret_cast<double**>(buffer);
+    AlignedDelete(buffer);
+  }
+  list->bytes = 0;
+}
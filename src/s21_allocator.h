@@ -0,0 +1,90 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_ALLOCATOR_H_
+#define CPP_S21_MATRIXPLUS_SRC_S21_ALLOCATOR_H_
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+
+// Source of the element buffers of matrices too large for inline storage.
+// Buffers must be aligned to 64 bytes. A matrix frees its buffer through the
+// allocator that provided it, so an allocator must outlive its matrices.
+class S21MatrixAllocator {
+ public:
+  virtual ~S21MatrixAllocator() = default;
+
+  virtual double* Allocate(std::size_t count) = 0;
+  virtual void Deallocate(double* buffer, std::size_t count) noexcept = 0;
+};
+
+// Plain aligned operator new and delete; the default.
+S21MatrixAllocator& S21HeapAllocator() noexcept;
+
+// Allocator used by matrices that were not given one. Passing nullptr
+// restores the heap allocator. Matrices keep the allocator they started
+// with when the process-wide one changes.
+void S21SetMatrixAllocator(S21MatrixAllocator* allocator) noexcept;
+S21MatrixAllocator& S21GetMatrixAllocator() noexcept;
+
+struct S21PoolStats {
+  long hits;
+  long misses;
+  std::size_t bytes_retained;
+};
+
+// Recycles freed buffers by size class. Classes are powers of two from
+// 2^kMinClassLog to 2^kMaxClassLog doubles; larger requests bypass the pool.
+// Each thread keeps up to kThreadCacheBytes per class in its own free lists,
+// spills half of a list that grows past that into the shared overflow, and
+// refills from the overflow before going to the heap. Free buffers are
+// chained through their first element, so recycling allocates nothing, and
+// they only go back to the heap through Trim().
+class S21BufferPool : public S21MatrixAllocator {
+ public:
+  // The pool shared by every thread. It is never destroyed, so threads can
+  // hand their caches back at exit regardless of destruction order.
+  static S21BufferPool& Instance();
+
+  S21BufferPool(const S21BufferPool&) = delete;
+  S21BufferPool& operator=(const S21BufferPool&) = delete;
+
+  double* Allocate(std::size_t count) override;
+  void Deallocate(double* buffer, std::size_t count) noexcept override;
+
+  S21PoolStats Stats() const noexcept;
+  // Frees the shared overflow and the calling thread's cache.
+  void Trim() noexcept;
+
+ private:
+  static constexpr int kMinClassLog = 5;
+  static constexpr int kMaxClassLog = 20;
+  static constexpr int kClasses = kMaxClassLog - kMinClassLog + 1;
+  static constexpr std::size_t kThreadCacheBytes = 1 << 20;
+
+  struct FreeList {
+    double* head = nullptr;
+    std::size_t bytes = 0;
+  };
+  struct ThreadCache {
+    FreeList lists[kClasses];
+    ~ThreadCache();
+  };
+
+  S21BufferPool() = default;
+
+  static ThreadCache& LocalCache() noexcept;
+  static int SizeClass(std::size_t count) noexcept;
+  static std::size_t ClassBytes(int size_class) noexcept;
+  static double* Pop(FreeList* list, std::size_t bytes) noexcept;
+  static void Push(FreeList* list, double* buffer, std::size_t bytes) noexcept;
+
+  void Spill(int size_class, FreeList* list, std::size_t keep) noexcept;
+  void Drain(FreeList* list) noexcept;
+
+  std::mutex mutex_;
+  FreeList overflow_[kClasses];
+  std::atomic<long> hits_{0};
+  std::atomic<long> misses_{0};
+  std::atomic<std::size_t> bytes_retained_{0};
+};
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_ALLOCATOR_H_
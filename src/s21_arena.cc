@@ -0,0 +1,65 @@
+#include "s21_arena.h"
+
+#include <algorithm>
+#include <new>
+
+S21Arena& S21Arena::Local() noexcept {
+  thread_local S21Arena arena;
+  return arena;
+}
+
+S21Arena::~S21Arena() noexcept { FreeBlocks(); }
+
+// Moves on to the first block with room left. Once the arena is empty again
+// after spilling over several blocks, they are merged into one, so a
+// repeated call is served from a single block.
+void* S21Arena::AllocateBytes(std::size_t bytes) {
+  bytes = (bytes + kAlignment - 1) / kAlignment * kAlignment;
+  if (block_ == 0 && used_ == 0 && blocks_.size() > 1) {
+    const std::size_t total = Capacity();
+    FreeBlocks();
+    AddBlock(total);
+  }
+  while (block_ < blocks_.size() && used_ + bytes > blocks_[block_].size) {
+    ++block_;
+    used_ = 0;
+  }
+  if (block_ == blocks_.size()) {
+    const std::size_t last = blocks_.empty() ? 0 : blocks_.back().size;
+    AddBlock(std::max({bytes, kMinBlock, 2 * last}));
+  }
+  void* result = blocks_[block_].data + used_;
+  used_ += bytes;
+  return result;
+}
+
+S21Arena::Mark S21Arena::GetMark() const noexcept { return {block_, used_}; }
+
+void S21Arena::Release(Mark mark) noexcept {
+  block_ = mark.block;
+  used_ = mark.used;
+}
+
+std::size_t S21Arena::Capacity() const noexcept {
+  std::size_t total = 0;
+  for (const Block& block : blocks_) {
+    total += block.size;
+  }
+  return total;
+}
+
+void S21Arena::AddBlock(std::size_t size) {
+  blocks_.reserve(blocks_.size() + 1);
+  char* data =
+      static_cast<char*>(::operator new(size, std::align_val_t{kAlignment}));
+  blocks_.push_back({data, size});
+}
+
+void S21Arena::FreeBlocks() noexcept {
+  for (const Block& block : blocks_) {
+    ::operator delete(block.data, std::align_val_t{kAlignment});
+  }
+  blocks_.clear();
+  block_ = 0;
+  used_ = 0;
+}
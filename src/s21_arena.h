@@ -0,0 +1,74 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_ARENA_H_
+#define CPP_S21_MATRIXPLUS_SRC_S21_ARENA_H_
+
+#include <cstddef>
+#include <vector>
+
+// Per-thread bump allocator for the scratch buffers of matrix algorithms.
+// Allocation only advances an offset, and everything handed out after a mark
+// is released at once by rolling back to it; blocks are kept for the next
+// call, so after warm-up the hot paths make no heap calls. Memory is only
+// suitable for trivially destructible types and is 64-byte aligned.
+class S21Arena {
+ public:
+  // Position in the arena that Release() rolls back to.
+  struct Mark {
+    std::size_t block;
+    std::size_t used;
+  };
+
+  // The calling thread's arena.
+  static S21Arena& Local() noexcept;
+
+  S21Arena() noexcept = default;
+  S21Arena(const S21Arena&) = delete;
+  S21Arena& operator=(const S21Arena&) = delete;
+  ~S21Arena() noexcept;
+
+  void* AllocateBytes(std::size_t bytes);
+  template <typename T>
+  T* Allocate(std::size_t count) {
+    return static_cast<T*>(AllocateBytes(count * sizeof(T)));
+  }
+  Mark GetMark() const noexcept;
+  void Release(Mark mark) noexcept;
+  std::size_t Capacity() const noexcept;
+
+ private:
+  static constexpr std::size_t kAlignment = 64;
+  static constexpr std::size_t kMinBlock = 1 << 16;
+
+  struct Block {
+    char* data;
+    std::size_t size;
+  };
+
+  std::vector<Block> blocks_;
+  std::size_t block_{0};
+  std::size_t used_{0};
+
+  void AddBlock(std::size_t size);
+  void FreeBlocks() noexcept;
+};
+
+// Scratch space from the calling thread's arena that lives until the end of
+// the enclosing scope.
+class S21ArenaScope {
+ public:
+  S21ArenaScope() noexcept
+      : arena_(S21Arena::Local()), mark_(arena_.GetMark()) {}
+  S21ArenaScope(const S21ArenaScope&) = delete;
+  S21ArenaScope& operator=(const S21ArenaScope&) = delete;
+  ~S21ArenaScope() noexcept { arena_.Release(mark_); }
+
+  template <typename T>
+  T* Allocate(std::size_t count) {
+    return arena_.Allocate<T>(count);
+  }
+
+ private:
+  S21Arena& arena_;
+  S21Arena::Mark mark_;
+};
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_ARENA_H_
@@ -0,0 +1,202 @@
+#include "s21_cholesky.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "s21_gemm.h"
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+S21Cholesky::S21Cholesky(const S21ConstMatrixView& other) : l_(other) {
+  if (other.Rows() != other.Cols() || other.Rows() == 0) {
+    throw std::length_error("the matrix is not square or no matrix exists");
+  }
+  if (!Factor(l_.rows_, l_.matrix_, l_.stride_)) {
+    throw std::length_error("the matrix is not positive definite");
+  }
+  for (int i = 0; i < l_.rows_; ++i) {
+    std::fill(l_.Row(i) + i + 1, l_.Row(i) + l_.cols_, 0.0);
+    det_ *= l_.At(i, i) * l_.At(i, i);
+    log_det_ += 2 * std::log(l_.At(i, i));
+  }
+}
+
+double S21Cholesky::Determinant() const noexcept { return det_; }
+
+double S21Cholesky::LogDeterminant() const noexcept { return log_det_; }
+
+const S21Matrix& S21Cholesky::Lower() const noexcept { return l_; }
+
+S21Matrix S21Cholesky::Solve(const S21ConstMatrixView& b) const {
+  if (b.Rows() != l_.rows_ || b.Cols() == 0) {
+    throw std::length_error("different matrix dimensions or no matrix exists");
+  }
+  if (IsSingular(l_.rows_, l_.matrix_, l_.stride_)) {
+    throw std::length_error("matrix determinant is 0");
+  }
+  S21Matrix result(b);
+  Substitute(l_.rows_, result.cols_, l_.matrix_, l_.stride_, result.matrix_,
+             result.stride_);
+  return result;
+}
+
+S21Matrix S21Cholesky::Inverse() const {
+  std::call_once(inverse_once_, [this] {
+    S21Matrix identity(l_.rows_, l_.rows_);
+    for (int i = 0; i < l_.rows_; ++i) {
+      identity.At(i, i) = 1;
+    }
+    inverse_ = Solve(identity);
+  });
+  return inverse_;
+}
+
+namespace {
+
+// Work below which a parallel loop runs inline.
+constexpr int kParallelGrain = 1 << 14;
+
+}  // namespace
+
+// Right-looking blocked factorization. Each kBlock-wide diagonal block is
+// factored column by column, every element being what is left after
+// subtracting the dot product of the two rows of L to its left within the
+// block. The panel below it is then solved against the block's transpose
+// row by row, and the lower triangle of the trailing matrix takes a
+// symmetric rank-kBlock update L21 * L21^T, one GEMM per block column,
+// which is where almost all of the work goes. The panel rows and the
+// update blocks run in parallel. A pivot that is not positive, or NaN,
+// means A is not positive definite.
+template <typename T>
+bool S21Cholesky::Factor(int n, T* a, int lda) {
+  const auto row = [a, lda](int i) {
+    return a + static_cast<std::ptrdiff_t>(i) * lda;
+  };
+  const auto dot = [](const T* x, const T* y, int count) {
+    T sum = 0;
+    for (int k = 0; k < count; ++k) {
+      sum += x[k] * y[k];
+    }
+    return sum;
+  };
+  bool positive = true;
+  for (int k0 = 0; k0 < n && positive; k0 += kBlock) {
+    const int kb = std::min(kBlock, n - k0);
+    const int k1 = k0 + kb;
+    for (int j = k0; j < k1 && positive; ++j) {
+      T* row_j = row(j);
+      const T pivot = row_j[j] - dot(row_j + k0, row_j + k0, j - k0);
+      positive = pivot > 0;
+      if (positive) {
+        row_j[j] = std::sqrt(pivot);
+        for (int i = j + 1; i < k1; ++i) {
+          T* row_i = row(i);
+          row_i[j] = (row_i[j] - dot(row_i + k0, row_j + k0, j - k0)) /
+                     row_j[j];
+        }
+      }
+    }
+    if (positive && k1 < n) {
+      S21ParallelFor(k1, n, kParallelGrain / (kb * kb),
+                     [&](int begin, int end) {
+                       for (int i = begin; i < end; ++i) {
+                         T* row_i = row(i) + k0;
+                         for (int j = 0; j < kb; ++j) {
+                           const T* row_j = row(k0 + j) + k0;
+                           row_i[j] = (row_i[j] - dot(row_i, row_j, j)) /
+                                      row_j[j];
+                         }
+                       }
+                     });
+      // With fewer block columns than threads, the GEMMs run one after
+      // another and each spreads over the pool instead.
+      const int blocks = (n - k1 + kBlock - 1) / kBlock;
+      const int grain = blocks < S21ThreadCount() ? blocks : 1;
+      S21ParallelFor(0, blocks, grain, [&](int begin, int end) {
+        for (int block = begin; block < end; ++block) {
+          const int j0 = k1 + block * kBlock;
+          const int jb = std::min(kBlock, n - j0);
+          S21Gemm(false, true, n - j0, jb, kb, T{-1}, row(j0) + k0, lda,
+                  row(j0) + k0, lda, row(j0) + j0, lda);
+        }
+      });
+    }
+  }
+  return positive;
+}
+
+template <typename T>
+bool S21Cholesky::IsSingular(int n, const T* l, int ldl) noexcept {
+  const auto row = [l, ldl](int i) {
+    return l + static_cast<std::ptrdiff_t>(i) * ldl;
+  };
+  T norm = 0;
+  for (int i = 0; i < n; ++i) {
+    T diagonal = 0;
+    for (int k = 0; k <= i; ++k) {
+      diagonal += row(i)[k] * row(i)[k];
+    }
+    norm = std::max(norm, diagonal);
+  }
+  bool singular = false;
+  for (int i = 0; i < n && !singular; ++i) {
+    singular = S21NegligiblePivot(row(i)[i] * row(i)[i], norm, n);
+  }
+  return singular;
+}
+
+// Forward substitution with L, then back substitution with L^T, both by
+// kBlock-row blocks. Each block first takes a GEMM update from the rows
+// already solved and is then solved by row updates across all the
+// right-hand sides at once. Within a block, the back pass subtracts each
+// finished row of the solution from the rows above it, which reads L
+// along its rows.
+template <typename T>
+void S21Cholesky::Substitute(int n, int nrhs, const T* l, int ldl, T* b,
+                             int ldb) {
+  const S21BasicKernels<T>& kernels = S21ActiveKernels<T>();
+  const auto row = [b, ldb](int i) {
+    return b + static_cast<std::ptrdiff_t>(i) * ldb;
+  };
+  const auto l_row = [l, ldl](int i) {
+    return l + static_cast<std::ptrdiff_t>(i) * ldl;
+  };
+  for (int i0 = 0; i0 < n; i0 += kBlock) {
+    const int i1 = std::min(n, i0 + kBlock);
+    if (i0 > 0) {
+      S21Gemm(i1 - i0, nrhs, i0, T{-1}, l_row(i0), ldl, row(0), ldb,
+              row(i0), ldb);
+    }
+    for (int i = i0; i < i1; ++i) {
+      for (int k = i0; k < i; ++k) {
+        kernels.axpy(nrhs, -l_row(i)[k], row(k), row(i));
+      }
+      kernels.scale(nrhs, T{1} / l_row(i)[i], row(i));
+    }
+  }
+  for (int i1 = n; i1 > 0; i1 -= kBlock) {
+    const int i0 = std::max(0, i1 - kBlock);
+    if (i1 < n) {
+      S21Gemm(true, false, i1 - i0, nrhs, n - i1, T{-1}, l_row(i1) + i0, ldl,
+              row(i1), ldb, row(i0), ldb);
+    }
+    for (int i = i1 - 1; i >= i0; --i) {
+      kernels.scale(nrhs, T{1} / l_row(i)[i], row(i));
+      for (int k = i0; k < i; ++k) {
+        kernels.axpy(nrhs, -l_row(i)[k], row(i), row(k));
+      }
+    }
+  }
+}
+
+template bool S21Cholesky::Factor(int n, double* a, int lda);
+template bool S21Cholesky::Factor(int n, float* a, int lda);
+template bool S21Cholesky::IsSingular(int n, const double* l,
+                                      int ldl) noexcept;
+template bool S21Cholesky::IsSingular(int n, const float* l,
+                                      int ldl) noexcept;
+template void S21Cholesky::Substitute(int n, int nrhs, const double* l,
+                                      int ldl, double* b, int ldb);
+template void S21Cholesky::Substitute(int n, int nrhs, const float* l,
+                                      int ldl, float* b, int ldb);
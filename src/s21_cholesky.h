@@ -0,0 +1,61 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_CHOLESKY_H_
+#define CPP_S21_MATRIXPLUS_SRC_S21_CHOLESKY_H_
+
+#include <mutex>
+
+#include "s21_matrix_oop.h"
+
+// Cholesky factorization A = L * L^T of a symmetric positive-definite matrix,
+// where L is lower triangular with a positive diagonal. It takes half the
+// work of LU and no pivoting. Only the lower triangle of A is read, so the
+// upper one may hold anything. Like S21LU, one object answers any number of
+// determinant, solve and inverse queries about the same matrix.
+class S21Cholesky {
+ public:
+  // Throws if the matrix is not square or not positive definite.
+  explicit S21Cholesky(const S21ConstMatrixView& other);
+  S21Cholesky(const S21Cholesky&) = delete;
+  S21Cholesky& operator=(const S21Cholesky&) = delete;
+
+  // The determinant of a positive-definite matrix is positive, so its
+  // logarithm always exists.
+  double Determinant() const noexcept;
+  double LogDeterminant() const noexcept;
+  // Solution x of A * x = b for every column of b. Throws like
+  // S21Matrix::InverseMatrix() when IsSingular() holds for L.
+  S21Matrix Solve(const S21ConstMatrixView& b) const;
+  // The inverse is computed by the first call and shared with the
+  // matrices later calls return.
+  S21Matrix Inverse() const;
+  // The factor L, with zeros above the diagonal.
+  const S21Matrix& Lower() const noexcept;
+
+  // Replaces the lower triangle of the n x n row-major matrix at a with L
+  // and leaves the strict upper triangle unspecified. Returns false, with
+  // L unspecified too, if the matrix is not positive definite. T is double
+  // or float.
+  template <typename T>
+  static bool Factor(int n, T* a, int lda);
+  // Whether a pivot L(i, i)^2 of L from Factor() is negligible against the
+  // largest diagonal element of A, which is the largest element of a
+  // positive-definite matrix and comes back from L as a row norm.
+  template <typename T>
+  static bool IsSingular(int n, const T* l, int ldl) noexcept;
+  // Overwrites the n x nrhs row-major matrix at b, rows ldb apart, with the
+  // solution of A * X = B, given L from Factor().
+  template <typename T>
+  static void Substitute(int n, int nrhs, const T* l, int ldl, T* b,
+                         int ldb);
+
+ private:
+  // Width of the column panels factored between two trailing updates.
+  static constexpr int kBlock = 64;
+
+  S21Matrix l_;
+  double det_{1};
+  double log_det_{0};
+  mutable std::once_flag inverse_once_;
+  mutable S21Matrix inverse_;
+};
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_CHOLESKY_H_
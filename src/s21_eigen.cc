@@ -0,0 +1,584 @@
+#include "s21_eigen.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+#include "s21_arena.h"
+#include "s21_gemm.h"
+#include "s21_qr.h"
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Columns reduced between two updates of the trailing matrix.
+constexpr int kBlock = 32;
+// Largest tridiagonal block divide and conquer solves by QL iteration.
+constexpr int kLeafSize = 32;
+// Work below which a parallel loop runs inline.
+constexpr int kParallelGrain = 1 << 14;
+// Iterations allowed per eigenvalue of QL and per root of the secular
+// equation; both converge in a handful.
+constexpr int kMaxIterations = 100;
+
+constexpr double kEpsilon = std::numeric_limits<double>::epsilon();
+
+double Dot(int count, const double* x, const double* y) {
+  double sum[4] = {0, 0, 0, 0};
+  int i = 0;
+  for (; i + 4 <= count; i += 4) {
+    sum[0] += x[i] * y[i];
+    sum[1] += x[i + 1] * y[i + 1];
+    sum[2] += x[i + 2] * y[i + 2];
+    sum[3] += x[i + 3] * y[i + 3];
+  }
+  for (; i < count; ++i) {
+    sum[0] += x[i] * y[i];
+  }
+  return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+// y = A * x for the symmetric n x n matrix at a, reading only its lower
+// triangle, so that each element comes from memory once: row r gives the
+// dot product for y(r) and, as column r of the upper triangle, an axpy
+// into y(0 : r). The rows are split into parts of about equal area, each
+// summing into its own n elements of partial, one per thread.
+void SymmetricProduct(int n, const double* a, int lda, const double* x,
+                      double* y, double* partial) {
+  const int parts = static_cast<int>(std::min<long>(
+      S21ThreadCount(), 1 + static_cast<long>(n) * n / (2 * kParallelGrain)));
+  const auto bound = [n, parts](int q) {
+    return static_cast<int>(n * std::sqrt(static_cast<double>(q) / parts));
+  };
+  S21ParallelFor(0, parts, 1, [&](int begin, int end) {
+    const auto axpy = S21ActiveKernels<double>().axpy;
+    for (int q = begin; q < end; ++q) {
+      double* sum = partial + static_cast<std::ptrdiff_t>(q) * n;
+      const int last = bound(q + 1);
+      std::fill(sum, sum + last, 0.0);
+      for (int r = bound(q); r < last; ++r) {
+        const double* a_r = a + static_cast<std::ptrdiff_t>(r) * lda;
+        sum[r] += Dot(r, a_r, x) + a_r[r] * x[r];
+        axpy(r, x[r], a_r, sum);
+      }
+    }
+  });
+  std::fill(y, y + n, 0.0);
+  for (int q = 0; q < parts; ++q) {
+    const double* sum = partial + static_cast<std::ptrdiff_t>(q) * n;
+    for (int r = 0; r < bound(q + 1); ++r) {
+      y[r] += sum[r];
+    }
+  }
+}
+
+// Reduces the symmetric n x n matrix at a, both triangles filled in, to
+// tridiagonal form Q^T * A * Q with diagonal d and subdiagonal e. Q =
+// H(0) * ... * H(n - 2), where H(i) = I - tau[i] * v * v^T has v(i + 1) = 1
+// and the rest of v below it in column i of a, so that the n - 1 x n - 1
+// matrix at a + lda holds Q as S21QR::ApplyQ() expects it.
+//
+// kBlock columns are reduced at a time. Within a panel, the trailing matrix
+// is left as it was and the reflections so far are kept as V and W, with
+// A - V * W^T - W * V^T being the matrix they have produced; each column
+// is brought up to date just before it is reduced, and each matrix-vector
+// product with the trailing matrix is corrected the same way. After the
+// panel, the trailing matrix takes the whole rank-2 * kBlock update in two
+// GEMMs. The matrix-vector products, half the work, read the lower
+// triangle only.
+void Tridiagonalize(int n, double* a, int lda, double* d, double* e,
+                    double* tau) {
+  const auto row = [a, lda](int i) {
+    return a + static_cast<std::ptrdiff_t>(i) * lda;
+  };
+  S21ArenaScope scratch;
+  double* v = scratch.Allocate<double>(static_cast<long>(n) * kBlock);
+  double* w = scratch.Allocate<double>(static_cast<long>(n) * kBlock);
+  double* x = scratch.Allocate<double>(n);
+  double* y = scratch.Allocate<double>(n);
+  double* partial =
+      scratch.Allocate<double>(static_cast<long>(S21ThreadCount()) * n);
+  double* vt_x = scratch.Allocate<double>(kBlock);
+  double* wt_x = scratch.Allocate<double>(kBlock);
+  for (int i0 = 0; i0 < n - 1; i0 += kBlock) {
+    const int nb = std::min(kBlock, n - 1 - i0);
+    // Row r of V and W, for r > i0.
+    const auto v_row = [v, i0](int r) {
+      return v + static_cast<std::ptrdiff_t>(r - i0 - 1) * kBlock;
+    };
+    const auto w_row = [w, i0](int r) {
+      return w + static_cast<std::ptrdiff_t>(r - i0 - 1) * kBlock;
+    };
+    for (int j = 0; j < nb; ++j) {
+      const int i = i0 + j;
+      for (int r = i; r < n; ++r) {
+        x[r] = row(r)[i];
+      }
+      if (j > 0) {
+        const double* v_i = v_row(i);
+        const double* w_i = w_row(i);
+        for (int r = i; r < n; ++r) {
+          x[r] -= Dot(j, v_row(r), w_i) + Dot(j, w_row(r), v_i);
+        }
+      }
+      d[i] = x[i];
+      const double alpha = x[i + 1];
+      const double tail = std::sqrt(Dot(n - i - 2, x + i + 2, x + i + 2));
+      double beta = alpha;
+      tau[i] = 0;
+      if (tail != 0) {
+        beta = -std::copysign(std::hypot(alpha, tail), alpha);
+        tau[i] = (beta - alpha) / beta;
+        const double scale = 1 / (alpha - beta);
+        for (int r = i + 2; r < n; ++r) {
+          x[r] *= scale;
+          row(r)[i] = x[r];
+        }
+      }
+      e[i] = beta;
+      x[i + 1] = 1;
+      for (int r = i0 + 1; r < n; ++r) {
+        v_row(r)[j] = r > i ? x[r] : 0;
+        w_row(r)[j] = 0;
+      }
+      if (tau[i] != 0) {
+        const int len = n - i - 1;
+        SymmetricProduct(len, row(i + 1) + i + 1, lda, x + i + 1, y + i + 1,
+                         partial);
+        std::fill(vt_x, vt_x + j, 0.0);
+        std::fill(wt_x, wt_x + j, 0.0);
+        for (int r = i + 1; r < n; ++r) {
+          for (int c = 0; c < j; ++c) {
+            vt_x[c] += v_row(r)[c] * x[r];
+            wt_x[c] += w_row(r)[c] * x[r];
+          }
+        }
+        for (int r = i + 1; r < n; ++r) {
+          y[r] = tau[i] *
+                 (y[r] - Dot(j, v_row(r), wt_x) - Dot(j, w_row(r), vt_x));
+        }
+        const double correction =
+            -0.5 * tau[i] * Dot(len, y + i + 1, x + i + 1);
+        for (int r = i + 1; r < n; ++r) {
+          w_row(r)[j] = y[r] + correction * x[r];
+        }
+      }
+    }
+    const int k0 = i0 + nb;
+    S21Gemm(false, true, n - k0, n - k0, nb, -1.0, v_row(k0), kBlock,
+            w_row(k0), kBlock, row(k0) + k0, lda);
+    S21Gemm(false, true, n - k0, n - k0, nb, -1.0, w_row(k0), kBlock,
+            v_row(k0), kBlock, row(k0) + k0, lda);
+  }
+  d[n - 1] = row(n - 1)[n - 1];
+}
+
+// Eigenvalues of the symmetric tridiagonal matrix with diagonal d and
+// subdiagonal e by implicit QL iteration with Wilkinson shifts, written to
+// d in ascending order; e is destroyed. If z is given, its n x n matrix,
+// rows ldz apart, is multiplied on the right by the rotations, so starting
+// from I it ends with the eigenvectors as its columns. Throws if an
+// eigenvalue is still coupled to the next after kMaxIterations.
+void TridiagonalQl(int n, double* d, double* e, double* z, int ldz) {
+  e[n - 1] = 0;
+  for (int l = 0; l < n; ++l) {
+    bool split = false;
+    for (int iter = 0; !split && iter <= kMaxIterations; ++iter) {
+      int m = l;
+      while (m < n - 1 &&
+             std::abs(e[m]) > kEpsilon * std::abs(d[m]) +
+                                  kEpsilon * std::abs(d[m + 1])) {
+        ++m;
+      }
+      split = m == l;
+      if (!split && iter < kMaxIterations) {
+        double g = (d[l + 1] - d[l]) / (2 * e[l]);
+        double r = std::hypot(g, 1.0);
+        g = d[m] - d[l] + e[l] / (g + std::copysign(r, g));
+        double s = 1, c = 1, p = 0;
+        int i = m - 1;
+        for (; i >= l; --i) {
+          const double f = s * e[i];
+          const double b = c * e[i];
+          r = std::hypot(f, g);
+          e[i + 1] = r;
+          if (r == 0) {
+            break;
+          }
+          s = f / r;
+          c = g / r;
+          g = d[i + 1] - p;
+          r = (d[i] - g) * s + 2 * c * b;
+          p = s * r;
+          d[i + 1] = g + p;
+          g = c * r - b;
+          if (z) {
+            for (int k = 0; k < n; ++k) {
+              double* z_k = z + static_cast<std::ptrdiff_t>(k) * ldz;
+              const double z_next = z_k[i + 1];
+              z_k[i + 1] = s * z_k[i] + c * z_next;
+              z_k[i] = c * z_k[i] - s * z_next;
+            }
+          }
+        }
+        if (i >= l) {
+          d[i + 1] -= p;
+          e[m] = 0;
+        } else {
+          d[l] -= p;
+          e[l] = g;
+          e[m] = 0;
+        }
+      }
+    }
+    if (!split) {
+      throw std::length_error("the eigenvalues did not converge");
+    }
+  }
+  if (z) {
+    for (int i = 0; i < n - 1; ++i) {
+      const int smallest =
+          static_cast<int>(std::min_element(d + i, d + n) - d);
+      if (smallest != i) {
+        std::swap(d[i], d[smallest]);
+        for (int k = 0; k < n; ++k) {
+          double* z_k = z + static_cast<std::ptrdiff_t>(k) * ldz;
+          std::swap(z_k[i], z_k[smallest]);
+        }
+      }
+    }
+  } else {
+    std::sort(d, d + n);
+  }
+}
+
+// Root lambda of the secular equation 1 + sum weight[b] / (d[b] - lambda)
+// = 0 that lies above d[a], for ascending d and positive weights: below
+// d[a + 1], or for the last one below d[a] plus the sum of the weights.
+// The root is found relative to the nearer of the poles around it, so
+// delta[b] = d[b] - lambda comes out accurate even next to that pole. Each
+// step solves a model with the same poles, value and slope on each side,
+// falling back to bisection whenever the model's root leaves the bracket.
+double SecularRoot(int k, const double* d, const double* weight, int a,
+                   double* delta) {
+  const bool last = a == k - 1;
+  int origin = a;
+  double low = 0;
+  double high = 0;
+  if (last) {
+    high = std::accumulate(weight, weight + k, 0.0);
+  } else {
+    const double half = (d[a + 1] - d[a]) / 2;
+    double f = 1;
+    for (int b = 0; b < k; ++b) {
+      f += weight[b] / ((d[b] - d[a]) - half);
+    }
+    if (f >= 0) {
+      high = half;
+    } else {
+      origin = a + 1;
+      low = -half;
+    }
+  }
+  const double shift = d[origin];
+  double tau = (low + high) / 2;
+  for (int iter = 0; iter < kMaxIterations; ++iter) {
+    double psi = 0, psi_slope = 0, phi = 0, phi_slope = 0;
+    for (int b = 0; b < k; ++b) {
+      delta[b] = (d[b] - shift) - tau;
+      const double term = weight[b] / delta[b];
+      if (b <= a) {
+        psi += term;
+        psi_slope += term / delta[b];
+      } else {
+        phi += term;
+        phi_slope += term / delta[b];
+      }
+    }
+    const double f = 1 + psi + phi;
+    if (f < 0) {
+      low = tau;
+    } else {
+      high = tau;
+    }
+    if (std::abs(f) <= 8 * kEpsilon * k * (1 + std::abs(psi) + std::abs(phi)) ||
+        high - low <= 2 * kEpsilon * std::max(std::abs(low), std::abs(high))) {
+      break;
+    }
+    const double left = delta[a];
+    const double b1 = psi_slope * left * left;
+    double step = 0;
+    if (last) {
+      step = left + b1 / (1 + psi - b1 / left + phi);
+    } else {
+      const double right = delta[a + 1];
+      const double b2 = phi_slope * right * right;
+      const double c = 1 + psi - b1 / left + phi - b2 / right;
+      const double sum = c * (left + right) + b1 + b2;
+      const double product = c * left * right + b1 * right + b2 * left;
+      const double root =
+          std::sqrt(std::max(0.0, sum * sum - 4 * c * product));
+      const double q = (sum + std::copysign(root, sum)) / 2;
+      step = q != 0 ? product / q : 0;
+      if (c != 0 && !(tau + step > low && tau + step < high)) {
+        step = q / c;
+      }
+    }
+    tau = tau + step > low && tau + step < high ? tau + step
+                                                : (low + high) / 2;
+  }
+  for (int b = 0; b < k; ++b) {
+    delta[b] = (d[b] - shift) - tau;
+  }
+  return shift + tau;
+}
+
+// Merges the solved halves [lo, mid) and [mid, hi) of a torn tridiagonal
+// matrix, whose eigenvectors are the diagonal blocks of z, joined by the
+// subdiagonal element beta. In the eigenbases of the halves, the joined
+// matrix is D + rho * u * u^T. Components of u too small to matter, and
+// pairs of eigenvalues close enough to be rotated into one, deflate: their
+// eigenpairs carry over. The rest are roots of the secular equation. Their
+// eigenvectors come from u recomputed to match the roots, which keeps them
+// orthogonal, and are taken back through the halves' eigenvectors by one
+// GEMM. d[lo, hi) and the block of z end sorted by eigenvalue.
+void Merge(int lo, int mid, int hi, double beta, double* d, double* z,
+           int ldz) {
+  const int m = hi - lo;
+  const auto z_at = [z, ldz](int i, int j) -> double& {
+    return z[static_cast<std::ptrdiff_t>(i) * ldz + j];
+  };
+  S21ArenaScope scratch;
+  double* dl = scratch.Allocate<double>(m);
+  double* u = scratch.Allocate<double>(m);
+  int* order = scratch.Allocate<int>(m);
+  int* kept = scratch.Allocate<int>(m);
+  int* deflated = scratch.Allocate<int>(m);
+  for (int j = 0; j < m; ++j) {
+    u[j] = j < mid - lo ? z_at(mid - 1, lo + j) : z_at(mid, lo + j);
+  }
+  const double norm = std::sqrt(Dot(m, u, u));
+  double rho = beta * norm * norm;
+  for (int j = 0; j < m; ++j) {
+    u[j] /= norm;
+  }
+  // A negative rho is made positive by negating D; the eigenvalues are
+  // negated back at the end.
+  const double sign = rho < 0 ? -1 : 1;
+  rho = std::abs(rho);
+  double largest = rho;
+  for (int j = 0; j < m; ++j) {
+    dl[j] = sign * d[lo + j];
+    largest = std::max(largest, std::abs(dl[j]));
+  }
+  std::iota(order, order + m, 0);
+  std::sort(order, order + m, [dl](int i, int j) { return dl[i] < dl[j]; });
+  const double tolerance = 8 * kEpsilon * largest;
+  int k = 0;
+  int deflated_count = 0;
+  for (int t = 0; t < m; ++t) {
+    const int j = order[t];
+    if (rho * std::abs(u[j]) <= tolerance) {
+      deflated[deflated_count++] = j;
+    } else {
+      const int i = k > 0 ? kept[k - 1] : -1;
+      const double r = i >= 0 ? std::hypot(u[i], u[j]) : 0;
+      const double c = i >= 0 ? u[j] / r : 0;
+      const double s = i >= 0 ? u[i] / r : 0;
+      if (i >= 0 && std::abs((dl[j] - dl[i]) * c * s) <= tolerance) {
+        for (int row = lo; row < hi; ++row) {
+          const double z_i = z_at(row, lo + i);
+          const double z_j = z_at(row, lo + j);
+          z_at(row, lo + i) = c * z_i - s * z_j;
+          z_at(row, lo + j) = s * z_i + c * z_j;
+        }
+        const double d_i = dl[i] * c * c + dl[j] * s * s;
+        dl[j] = dl[i] * s * s + dl[j] * c * c;
+        dl[i] = d_i;
+        u[i] = 0;
+        u[j] = r;
+        deflated[deflated_count++] = i;
+        kept[k - 1] = j;
+      } else {
+        kept[k++] = j;
+      }
+    }
+  }
+
+  double* dk = scratch.Allocate<double>(k);
+  double* weight = scratch.Allocate<double>(k);
+  double* roots = scratch.Allocate<double>(k);
+  double* u_hat = scratch.Allocate<double>(k);
+  double* delta = scratch.Allocate<double>(static_cast<long>(k) * k);
+  double* vectors = scratch.Allocate<double>(static_cast<long>(k) * k);
+  for (int b = 0; b < k; ++b) {
+    dk[b] = dl[kept[b]];
+    weight[b] = rho * u[kept[b]] * u[kept[b]];
+  }
+  S21ParallelFor(0, k, std::max(1, kParallelGrain / (8 * k + 1)),
+                 [&](int begin, int end) {
+                   for (int a = begin; a < end; ++a) {
+                     roots[a] = SecularRoot(k, dk, weight, a,
+                                            delta + static_cast<long>(a) * k);
+                   }
+                 });
+  const auto delta_at = [delta, k](int a, int b) {
+    return delta[static_cast<long>(a) * k + b];
+  };
+  for (int b = 0; b < k; ++b) {
+    double product = -delta_at(b, b) / rho;
+    for (int a = 0; a < k; ++a) {
+      if (a != b) {
+        product *= delta_at(a, b) / (dk[b] - dk[a]);
+      }
+    }
+    u_hat[b] = std::copysign(std::sqrt(std::abs(product)), u[kept[b]]);
+  }
+  for (int a = 0; a < k; ++a) {
+    double sum = 0;
+    for (int b = 0; b < k; ++b) {
+      const double value = u_hat[b] / delta_at(a, b);
+      vectors[static_cast<long>(b) * k + a] = value;
+      sum += value * value;
+    }
+    const double scale = 1 / std::sqrt(sum);
+    for (int b = 0; b < k; ++b) {
+      vectors[static_cast<long>(b) * k + a] *= scale;
+    }
+  }
+
+  double* basis = scratch.Allocate<double>(static_cast<long>(m) * k);
+  double* merged = scratch.Allocate<double>(static_cast<long>(m) * k);
+  for (int row = 0; row < m; ++row) {
+    for (int b = 0; b < k; ++b) {
+      basis[static_cast<long>(row) * k + b] = z_at(lo + row, lo + kept[b]);
+    }
+  }
+  std::fill(merged, merged + static_cast<long>(m) * k, 0.0);
+  S21Gemm(m, k, k, 1.0, basis, k, vectors, k, merged, k);
+
+  // Eigenpair t is root t below k, and deflated pair t - k after it.
+  int* pairs = scratch.Allocate<int>(m);
+  double* values = scratch.Allocate<double>(m);
+  double* out = scratch.Allocate<double>(static_cast<long>(m) * m);
+  for (int t = 0; t < m; ++t) {
+    pairs[t] = t;
+    values[t] = sign * (t < k ? roots[t] : dl[deflated[t - k]]);
+  }
+  std::sort(pairs, pairs + m,
+            [values](int i, int j) { return values[i] < values[j]; });
+  for (int t = 0; t < m; ++t) {
+    const int pair = pairs[t];
+    d[lo + t] = values[pair];
+    for (int row = 0; row < m; ++row) {
+      out[static_cast<long>(row) * m + t] =
+          pair < k ? merged[static_cast<long>(row) * k + pair]
+                   : z_at(lo + row, lo + deflated[pair - k]);
+    }
+  }
+  for (int row = 0; row < m; ++row) {
+    std::copy(out + static_cast<long>(row) * m,
+              out + static_cast<long>(row + 1) * m, &z_at(lo + row, lo));
+  }
+}
+
+// Eigenvalues, into d in ascending order, and eigenvectors, as the columns
+// of the n x n matrix at z, of the symmetric tridiagonal matrix with
+// diagonal d and subdiagonal e. The matrix is torn into a power of two of
+// blocks of at most kLeafSize by subtracting each joining element from
+// the diagonal on both sides of it; the blocks are solved by QL iteration
+// and merged pairwise back up. The blocks, and the merges on the lower
+// levels, run in parallel; the few large merges at the top leave the pool
+// to their GEMMs.
+void DivideAndConquer(int n, double* d, const double* e, double* z,
+                      int ldz) {
+  int leaves = 1;
+  while ((n + leaves - 1) / leaves > kLeafSize) {
+    leaves *= 2;
+  }
+  S21ArenaScope scratch;
+  int* bounds = scratch.Allocate<int>(leaves + 1);
+  for (int q = 0; q <= leaves; ++q) {
+    bounds[q] = static_cast<int>(static_cast<long>(n) * q / leaves);
+  }
+  for (int q = 1; q < leaves; ++q) {
+    d[bounds[q] - 1] -= e[bounds[q] - 1];
+    d[bounds[q]] -= e[bounds[q] - 1];
+  }
+  for (int i = 0; i < n; ++i) {
+    std::fill(z + static_cast<std::ptrdiff_t>(i) * ldz,
+              z + static_cast<std::ptrdiff_t>(i) * ldz + n, 0.0);
+  }
+  S21ParallelFor(0, leaves, 1, [&](int begin, int end) {
+    S21ArenaScope leaf_scratch;
+    double* sub = leaf_scratch.Allocate<double>(kLeafSize);
+    for (int q = begin; q < end; ++q) {
+      const int lo = bounds[q];
+      const int size = bounds[q + 1] - lo;
+      std::copy(e + lo, e + lo + size - 1, sub);
+      double* block = z + static_cast<std::ptrdiff_t>(lo) * ldz + lo;
+      for (int i = 0; i < size; ++i) {
+        block[static_cast<std::ptrdiff_t>(i) * ldz + i] = 1;
+      }
+      TridiagonalQl(size, d + lo, sub, block, ldz);
+    }
+  });
+  for (int width = 1; width < leaves; width *= 2) {
+    const int merges = leaves / (2 * width);
+    S21ParallelFor(0, merges, merges < S21ThreadCount() ? merges : 1,
+                   [&](int begin, int end) {
+                     for (int q = begin; q < end; ++q) {
+                       const int lo = bounds[2 * q * width];
+                       const int mid = bounds[(2 * q + 1) * width];
+                       const int hi = bounds[(2 * q + 2) * width];
+                       Merge(lo, mid, hi, e[mid - 1], d, z, ldz);
+                     }
+                   });
+  }
+}
+
+}  // namespace
+
+S21Eigen::S21Eigen(const S21ConstMatrixView& other, bool vectors)
+    : has_vectors_(vectors) {
+  if (other.Rows() != other.Cols() || other.Rows() == 0) {
+    throw std::length_error("the matrix is not square or no matrix exists");
+  }
+  const int n = other.Rows();
+  S21Matrix a(other);
+  for (int i = 0; i < n; ++i) {
+    for (int j = i + 1; j < n; ++j) {
+      a.At(i, j) = a.At(j, i);
+    }
+  }
+  values_.resize(n);
+  std::vector<double> e(n);
+  std::vector<double> tau(n);
+  Tridiagonalize(n, a.matrix_, a.stride_, values_.data(), e.data(),
+                 tau.data());
+  if (vectors) {
+    vectors_ = S21Matrix(n, n);
+    DivideAndConquer(n, values_.data(), e.data(), vectors_.matrix_,
+                     vectors_.stride_);
+    if (n > 1) {
+      S21QR::ApplyQ(n - 1, n - 1, n, a.Row(1), a.stride_, tau.data(),
+                    vectors_.Row(1), vectors_.stride_);
+    }
+  } else {
+    TridiagonalQl(n, values_.data(), e.data(), nullptr, 0);
+  }
+}
+
+const std::vector<double>& S21Eigen::Values() const noexcept {
+  return values_;
+}
+
+const S21Matrix& S21Eigen::Vectors() const {
+  if (!has_vectors_) {
+    throw std::length_error("the eigenvectors were not computed");
+  }
+  return vectors_;
+}
@@ -0,0 +1,33 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_EIGEN_H_
+#define CPP_S21_MATRIXPLUS_SRC_S21_EIGEN_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Eigendecomposition A = V * diag(w) * V^T of a symmetric matrix, where V
+// is orthogonal. Only the lower triangle of A is read. A is first reduced
+// to tridiagonal form by blocked Householder reflections. The eigenvalues
+// of the tridiagonal matrix come from implicit QL iteration in O(n^2), or,
+// when eigenvectors are wanted, from divide and conquer, whose merges are
+// matrix products. The reflections then carry the eigenvectors back to A.
+class S21Eigen {
+ public:
+  // Throws if the matrix is not square, or in the unlikely event that QL
+  // iteration fails to converge. Without vectors only the eigenvalues are
+  // computed, in a fraction of the time.
+  explicit S21Eigen(const S21ConstMatrixView& other, bool vectors = true);
+
+  // The eigenvalues in ascending order.
+  const std::vector<double>& Values() const noexcept;
+  // Column j is the unit eigenvector of Values()[j]. Throws if the object
+  // was built without vectors.
+  const S21Matrix& Vectors() const;
+
+ private:
+  std::vector<double> values_;
+  S21Matrix vectors_;
+  bool has_vectors_{false};
+};
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_EIGEN_H_
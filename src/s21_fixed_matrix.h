@@ -0,0 +1,295 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_FIXED_MATRIX_H_
+#define CPP_S21_MATRIXPLUS_SRC_S21_FIXED_MATRIX_H_
+
+#include <array>
+#include <stdexcept>
+
+#include "s21_matrix_oop.h"
+
+// R x C matrix with inline storage for small transforms. Dimensions are
+// checked at compile time, nothing is allocated, and every operation is
+// constexpr, so fixed-size math can fold to constants or stay in registers.
+// Square sizes up to 3x3 use closed-form determinants and adjugates; larger
+// ones fall back to pivoted elimination with bounds the compiler can unroll.
+template <int R, int C>
+class S21FixedMatrix {
+  static_assert(R > 0 && C > 0, "matrix dimensions must be positive");
+
+ public:
+  constexpr S21FixedMatrix() noexcept = default;
+  // Elements in row-major order.
+  constexpr explicit S21FixedMatrix(const std::array<double, R * C>& values)
+      : matrix_(values) {}
+  explicit S21FixedMatrix(const S21Matrix& other) {
+    if (other.AccessRows() != R || other.AccessCols() != C) {
+      throw std::length_error("different matrix dimensions");
+    }
+    for (int i = 0; i < R; ++i) {
+      for (int j = 0; j < C; ++j) {
+        At(i, j) = other(i, j);
+      }
+    }
+  }
+
+  explicit operator S21Matrix() const {
+    S21Matrix result(R, C);
+    for (int i = 0; i < R; ++i) {
+      for (int j = 0; j < C; ++j) {
+        result(i, j) = At(i, j);
+      }
+    }
+    return result;
+  }
+
+  static constexpr int AccessRows() noexcept { return R; }
+  static constexpr int AccessCols() noexcept { return C; }
+
+  constexpr double& operator()(int i, int j) {
+    if (i < 0 || j < 0 || i >= R || j >= C) {
+      throw std::length_error("index is outside the matrix");
+    }
+    return At(i, j);
+  }
+  constexpr double operator()(int i, int j) const {
+    if (i < 0 || j < 0 || i >= R || j >= C) {
+      throw std::length_error("index is outside the matrix");
+    }
+    return At(i, j);
+  }
+
+  constexpr bool EqMatrix(const S21FixedMatrix& other) const noexcept {
+    bool equal = true;
+    for (int k = 0; k < R * C && equal; ++k) {
+      equal = Abs(matrix_[k] - other.matrix_[k]) < 1e-7;
+    }
+    return equal;
+  }
+
+  constexpr void SumMatrix(const S21FixedMatrix& other) noexcept {
+    for (int k = 0; k < R * C; ++k) {
+      matrix_[k] += other.matrix_[k];
+    }
+  }
+
+  constexpr void SubMatrix(const S21FixedMatrix& other) noexcept {
+    for (int k = 0; k < R * C; ++k) {
+      matrix_[k] -= other.matrix_[k];
+    }
+  }
+
+  constexpr void MulNumber(const double num) noexcept {
+    for (int k = 0; k < R * C; ++k) {
+      matrix_[k] *= num;
+    }
+  }
+
+  template <int K>
+  constexpr S21FixedMatrix<R, K> MulMatrix(
+      const S21FixedMatrix<C, K>& other) const noexcept {
+    S21FixedMatrix<R, K> result;
+    for (int i = 0; i < R; ++i) {
+      for (int k = 0; k < C; ++k) {
+        for (int j = 0; j < K; ++j) {
+          result.At(i, j) += At(i, k) * other.At(k, j);
+        }
+      }
+    }
+    return result;
+  }
+
+  constexpr S21FixedMatrix<C, R> Transpose() const noexcept {
+    S21FixedMatrix<C, R> result;
+    for (int i = 0; i < R; ++i) {
+      for (int j = 0; j < C; ++j) {
+        result.At(j, i) = At(i, j);
+      }
+    }
+    return result;
+  }
+
+  constexpr double Determinant() const noexcept {
+    static_assert(R == C, "the matrix is not square");
+    double result = 0;
+    if constexpr (R == 1) {
+      result = At(0, 0);
+    } else if constexpr (R == 2) {
+      result = At(0, 0) * At(1, 1) - At(1, 0) * At(0, 1);
+    } else if constexpr (R == 3) {
+      for (int i = 0; i < 3; ++i) {
+        result += At(0, i) * (At(1, (i + 1) % 3) * At(2, (i + 2) % 3) -
+                              At(1, (i + 2) % 3) * At(2, (i + 1) % 3));
+      }
+    } else {
+      S21FixedMatrix lu(*this);
+      result = lu.EliminateInPlace(false);
+    }
+    return result;
+  }
+
+  constexpr S21FixedMatrix InverseMatrix() const {
+    static_assert(R == C, "the matrix is not square");
+    S21FixedMatrix result;
+    double det = 0;
+    if constexpr (R <= 3) {
+      det = Determinant();
+      if (Abs(det) >= 1e-7) {
+        result = CalcComplements().Transpose();
+        result.MulNumber(1.0 / det);
+      }
+    } else {
+      result = *this;
+      det = result.EliminateInPlace(true);
+    }
+    if (Abs(det) < 1e-7) {
+      throw std::length_error("matrix determinant is 0");
+    }
+    return result;
+  }
+
+  // Cofactor matrix for sizes up to 3x3.
+  constexpr S21FixedMatrix CalcComplements() const noexcept {
+    static_assert(R == C && R <= 3, "closed-form complements need R == C <= 3");
+    S21FixedMatrix result;
+    if constexpr (R == 1) {
+      result.At(0, 0) = 1;
+    } else if constexpr (R == 2) {
+      result.At(0, 0) = At(1, 1);
+      result.At(0, 1) = -At(1, 0);
+      result.At(1, 0) = -At(0, 1);
+      result.At(1, 1) = At(0, 0);
+    } else {
+      for (int i = 0; i < R; ++i) {
+        for (int j = 0; j < R; ++j) {
+          result.At(i, j) =
+              At((i + 1) % 3, (j + 1) % 3) * At((i + 2) % 3, (j + 2) % 3) -
+              At((i + 1) % 3, (j + 2) % 3) * At((i + 2) % 3, (j + 1) % 3);
+        }
+      }
+    }
+    return result;
+  }
+
+  constexpr S21FixedMatrix& operator+=(const S21FixedMatrix& other) noexcept {
+    SumMatrix(other);
+    return *this;
+  }
+  constexpr S21FixedMatrix& operator-=(const S21FixedMatrix& other) noexcept {
+    SubMatrix(other);
+    return *this;
+  }
+  constexpr S21FixedMatrix& operator*=(const double other) noexcept {
+    MulNumber(other);
+    return *this;
+  }
+
+  constexpr S21FixedMatrix operator+(const S21FixedMatrix& other) const
+      noexcept {
+    S21FixedMatrix result(*this);
+    return result += other;
+  }
+  constexpr S21FixedMatrix operator-(const S21FixedMatrix& other) const
+      noexcept {
+    S21FixedMatrix result(*this);
+    return result -= other;
+  }
+  constexpr S21FixedMatrix operator*(const double other) const noexcept {
+    S21FixedMatrix result(*this);
+    return result *= other;
+  }
+  friend constexpr S21FixedMatrix operator*(
+      const double lhs, const S21FixedMatrix& rhs) noexcept {
+    return rhs * lhs;
+  }
+  template <int K>
+  constexpr S21FixedMatrix<R, K> operator*(
+      const S21FixedMatrix<C, K>& other) const noexcept {
+    return MulMatrix(other);
+  }
+  constexpr bool operator==(const S21FixedMatrix& other) const noexcept {
+    return EqMatrix(other);
+  }
+
+ private:
+  template <int, int>
+  friend class S21FixedMatrix;
+
+  std::array<double, R * C> matrix_{};
+
+  static constexpr double Abs(double value) noexcept {
+    return value < 0 ? -value : value;
+  }
+
+  constexpr double& At(int i, int j) noexcept { return matrix_[i * C + j]; }
+  constexpr double At(int i, int j) const noexcept {
+    return matrix_[i * C + j];
+  }
+
+  constexpr void SwapRows(int a, int b) noexcept {
+    for (int j = 0; j < C; ++j) {
+      const double tmp = At(a, j);
+      At(a, j) = At(b, j);
+      At(b, j) = tmp;
+    }
+  }
+
+  // Gauss-Jordan elimination with partial pivoting in place. Returns the
+  // determinant; if invert is set and the matrix is regular, the matrix is
+  // replaced by its inverse, otherwise the contents are unspecified.
+  constexpr double EliminateInPlace(bool invert) noexcept {
+    int pivots[R] = {};
+    double det = 1;
+    for (int k = 0; k < R && det != 0; ++k) {
+      int pivot = k;
+      for (int i = k + 1; i < R; ++i) {
+        if (Abs(At(i, k)) > Abs(At(pivot, k))) {
+          pivot = i;
+        }
+      }
+      pivots[k] = pivot;
+      if (pivot != k) {
+        SwapRows(k, pivot);
+        det = -det;
+      }
+      const double diag = At(k, k);
+      det *= diag;
+      if (diag != 0 && invert) {
+        At(k, k) = 1;
+        for (int j = 0; j < C; ++j) {
+          At(k, j) /= diag;
+        }
+        for (int i = 0; i < R; ++i) {
+          const double factor = At(i, k);
+          if (i != k && factor != 0) {
+            At(i, k) = 0;
+            for (int j = 0; j < C; ++j) {
+              At(i, j) -= factor * At(k, j);
+            }
+          }
+        }
+      } else if (diag != 0) {
+        for (int i = k + 1; i < R; ++i) {
+          const double factor = At(i, k) / diag;
+          for (int j = k + 1; j < C; ++j) {
+            At(i, j) -= factor * At(k, j);
+          }
+        }
+      }
+    }
+    for (int k = R - 1; k >= 0 && det != 0 && invert; --k) {
+      if (pivots[k] != k) {
+        for (int i = 0; i < R; ++i) {
+          const double tmp = At(i, k);
+          At(i, k) = At(i, pivots[k]);
+          At(i, pivots[k]) = tmp;
+        }
+      }
+    }
+    return det;
+  }
+};
+
+using S21Matrix2 = S21FixedMatrix<2, 2>;
+using S21Matrix3 = S21FixedMatrix<3, 3>;
+using S21Matrix4 = S21FixedMatrix<4, 4>;
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_FIXED_MATRIX_H_
@@ -0,0 +1,205 @@
+#include "s21_gemm.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "s21_arena.h"
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Cache blocks walked by the microkernel: a kKc x kNc panel of B stays in
+// L3, a kMc x kKc block of A in L2, and a kKc x nr sliver of B in L1. The
+// register tile mr x nr depends on the instruction set and the element
+// type; kMc and kNc are multiples of every tile size.
+constexpr int kMc = 96;
+constexpr int kKc = 256;
+constexpr int kNc = 2048;
+constexpr int kMaxMr = 8;
+constexpr int kMaxNr = 16;
+
+// Below this many multiply-adds packing costs more than it saves.
+constexpr long long kSmallGemm = 32 * 32 * 32;
+// From this many multiply-adds on, output tiles are spread over the pool.
+constexpr long long kParallelGemm = 128 * 128 * 128;
+// Narrowest column chunk worth giving to a separate thread.
+constexpr int kMinParallelCols = 64;
+
+// Input operand whose element (i, j) is data[i * row_stride +
+// j * col_stride], which covers both stored and transposed orientation.
+template <typename T>
+struct Operand {
+  const T* data;
+  long row_stride;
+  long col_stride;
+
+  T operator()(long i, long j) const noexcept {
+    return data[i * row_stride + j * col_stride];
+  }
+  Operand Shift(long i, long j) const noexcept {
+    return {data + i * row_stride + j * col_stride, row_stride, col_stride};
+  }
+};
+
+template <typename T>
+void SmallGemm(const S21BasicKernels<T>& kernels, int m, int n, int k,
+               T alpha, Operand<T> a, Operand<T> b, T* c, int ldc) noexcept {
+  for (int i = 0; i < m; ++i) {
+    T* c_row = c + static_cast<long>(i) * ldc;
+    if (b.col_stride == 1) {
+      for (int p = 0; p < k; ++p) {
+        kernels.axpy(n, alpha * a(i, p), b.Shift(p, 0).data, c_row);
+      }
+    } else {
+      for (int j = 0; j < n; ++j) {
+        T sum = 0;
+        for (int p = 0; p < k; ++p) {
+          sum += a(i, p) * b(p, j);
+        }
+        c_row[j] += alpha * sum;
+      }
+    }
+  }
+}
+
+// Copies an mc x kc block of A into mr-row slivers, each stored column by
+// column, padding the last sliver with zeros.
+template <typename T>
+void PackA(int mc, int kc, int mr, Operand<T> a, T* packed) noexcept {
+  for (int i = 0; i < mc; i += mr) {
+    const int rows = std::min(mr, mc - i);
+    for (int p = 0; p < kc; ++p) {
+      for (int r = 0; r < mr; ++r) {
+        *packed++ = r < rows ? a(i + r, p) : T{0};
+      }
+    }
+  }
+}
+
+// Copies a kc x nc block of B into nr-column slivers, each stored row by
+// row, padding the last sliver with zeros.
+template <typename T>
+void PackB(int kc, int nc, int nr, Operand<T> b, T* packed) noexcept {
+  for (int j = 0; j < nc; j += nr) {
+    const int cols = std::min(nr, nc - j);
+    for (int p = 0; p < kc; ++p) {
+      for (int r = 0; r < nr; ++r) {
+        *packed++ = r < cols ? b(p, j + r) : T{0};
+      }
+    }
+  }
+}
+
+// C[0:rows, 0:cols] += alpha * A_sliver * B_sliver. Partial tiles at the
+// matrix edges are computed into a scratch tile and copied out.
+template <typename T>
+void MicroTile(const S21BasicKernels<T>& kernels, int kc, T alpha, const T* a,
+               const T* b, T* c, int ldc, int rows, int cols) noexcept {
+  if (rows == kernels.gemm_mr && cols == kernels.gemm_nr) {
+    kernels.gemm_kernel(kc, alpha, a, b, c, ldc);
+  } else {
+    T tile[kMaxMr * kMaxNr] = {};
+    kernels.gemm_kernel(kc, alpha, a, b, tile, kernels.gemm_nr);
+    for (int i = 0; i < rows; ++i) {
+      kernels.add(cols, tile + i * kernels.gemm_nr,
+                  c + static_cast<long>(i) * ldc);
+    }
+  }
+}
+
+template <typename T>
+void BlockedGemm(const S21BasicKernels<T>& kernels, int m, int n, int k,
+                 T alpha, Operand<T> a, Operand<T> b, T* c, int ldc) noexcept {
+  const int mr = kernels.gemm_mr;
+  const int nr = kernels.gemm_nr;
+  S21ArenaScope scratch;
+  T* packed_a = scratch.Allocate<T>(static_cast<size_t>(kMc) * kKc);
+  T* packed_b = scratch.Allocate<T>(
+      static_cast<size_t>(kKc) * ((std::min(n, kNc) + nr - 1) / nr * nr));
+  for (int jc = 0; jc < n; jc += kNc) {
+    const int nc = std::min(kNc, n - jc);
+    for (int pc = 0; pc < k; pc += kKc) {
+      const int kc = std::min(kKc, k - pc);
+      PackB(kc, nc, nr, b.Shift(pc, jc), packed_b);
+      for (int ic = 0; ic < m; ic += kMc) {
+        const int mc = std::min(kMc, m - ic);
+        PackA(mc, kc, mr, a.Shift(ic, pc), packed_a);
+        for (int jr = 0; jr < nc; jr += nr) {
+          const T* b_sliver = packed_b + jr * kc;
+          for (int ir = 0; ir < mc; ir += mr) {
+            MicroTile(kernels, kc, alpha, packed_a + ir * kc, b_sliver,
+                      c + static_cast<long>(ic + ir) * ldc + jc + jr, ldc,
+                      std::min(mr, mc - ir), std::min(nr, nc - jr));
+          }
+        }
+      }
+    }
+  }
+}
+
+// Splits C into a grid of output tiles: row strips of at least kMc rows,
+// and, when there are fewer strips than threads, column chunks as well.
+// Every tile is an independent blocked product with its own packing.
+template <typename T>
+void ParallelGemm(const S21BasicKernels<T>& kernels, int m, int n, int k,
+                  T alpha, Operand<T> a, Operand<T> b, T* c, int ldc) {
+  const int threads = S21ThreadCount();
+  const int mr = kernels.gemm_mr;
+  const int nr = kernels.gemm_nr;
+  const int row_tiles = std::max(1, std::min(threads, (m + kMc - 1) / kMc));
+  const int col_tiles = std::max(
+      1, std::min((threads + row_tiles - 1) / row_tiles,
+                  (n + kMinParallelCols - 1) / kMinParallelCols));
+  const int tile_m = ((m + row_tiles - 1) / row_tiles + mr - 1) / mr * mr;
+  const int tile_n = ((n + col_tiles - 1) / col_tiles + nr - 1) / nr * nr;
+  const int grid_m = (m + tile_m - 1) / tile_m;
+  const int grid_n = (n + tile_n - 1) / tile_n;
+  S21ThreadPool::Instance().Run(grid_m * grid_n, [&](int tile) {
+    const int row = tile / grid_n * tile_m;
+    const int col = tile % grid_n * tile_n;
+    BlockedGemm(kernels, std::min(tile_m, m - row), std::min(tile_n, n - col),
+                k, alpha, a.Shift(row, 0), b.Shift(0, col),
+                c + static_cast<long>(row) * ldc + col, ldc);
+  });
+}
+
+}  // namespace
+
+template <typename T>
+void S21Gemm(int m, int n, int k, T alpha, const T* a, int lda, const T* b,
+             int ldb, T* c, int ldc) {
+  S21Gemm(false, false, m, n, k, alpha, a, lda, b, ldb, c, ldc);
+}
+
+template <typename T>
+void S21Gemm(bool trans_a, bool trans_b, int m, int n, int k, T alpha,
+             const T* a, int lda, const T* b, int ldb, T* c, int ldc) {
+  const S21BasicKernels<T>& kernels = S21ActiveKernels<T>();
+  const Operand<T> op_a =
+      trans_a ? Operand<T>{a, 1, lda} : Operand<T>{a, lda, 1};
+  const Operand<T> op_b =
+      trans_b ? Operand<T>{b, 1, ldb} : Operand<T>{b, ldb, 1};
+  const long long work = static_cast<long long>(m) * n * k;
+  if (work <= kSmallGemm) {
+    SmallGemm(kernels, m, n, k, alpha, op_a, op_b, c, ldc);
+  } else if (work >= kParallelGemm && S21ThreadCount() > 1) {
+    ParallelGemm(kernels, m, n, k, alpha, op_a, op_b, c, ldc);
+  } else {
+    BlockedGemm(kernels, m, n, k, alpha, op_a, op_b, c, ldc);
+  }
+}
+
+template void S21Gemm(int, int, int, double, const double*, int,
+                      const double*, int, double*, int);
+template void S21Gemm(int, int, int, float, const float*, int, const float*,
+                      int, float*, int);
+template void S21Gemm(int, int, int, std::int64_t, const std::int64_t*, int,
+                      const std::int64_t*, int, std::int64_t*, int);
+template void S21Gemm(bool, bool, int, int, int, double, const double*, int,
+                      const double*, int, double*, int);
+template void S21Gemm(bool, bool, int, int, int, float, const float*, int,
+                      const float*, int, float*, int);
+template void S21Gemm(bool, bool, int, int, int, std::int64_t,
+                      const std::int64_t*, int, const std::int64_t*, int,
+                      std::int64_t*, int);
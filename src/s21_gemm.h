@@ -0,0 +1,20 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_GEMM_H_
+#define CPP_S21_MATRIXPLUS_SRC_S21_GEMM_H_
+
+// General matrix multiply on row-major storage: C += alpha * A * B, where A
+// is m x k, B is k x n and C is m x n. lda, ldb and ldc are the row strides
+// of the three operands in elements. Large products run on S21ThreadPool.
+// T is double, float or std::int64_t, each with its own microkernel.
+template <typename T>
+void S21Gemm(int m, int n, int k, T alpha, const T* a, int lda, const T* b,
+             int ldb, T* c, int ldc);
+
+// The same with op(A) and op(B) in place of A and B, where op(X) is X or,
+// if the flag is set, its transpose. A transposed operand is read where it
+// is stored: a is then k x m with row stride lda, and b is n x k with row
+// stride ldb.
+template <typename T>
+void S21Gemm(bool trans_a, bool trans_b, int m, int n, int k, T alpha,
+             const T* a, int lda, const T* b, int ldb, T* c, int ldc);
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_GEMM_H_
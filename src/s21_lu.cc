@@ -0,0 +1,231 @@
+#include "s21_lu.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "s21_arena.h"
+#include "s21_gemm.h"
+#include "s21_simd.h"
+
+S21LU::S21LU(const S21ConstMatrixView& other) : lu_(other) {
+  if (other.Rows() != other.Cols() || other.Rows() == 0) {
+    throw std::length_error("the matrix is not square or no matrix exists");
+  }
+  const double norm = S21MaxAbs(lu_.rows_, lu_.cols_, lu_.matrix_,
+                                lu_.stride_);
+  pivots_.resize(lu_.rows_);
+  const int sign =
+      Factor(lu_.rows_, lu_.matrix_, lu_.stride_, pivots_.data());
+  singular_ = sign == 0;
+  det_ = sign;
+  log_abs_det_ = singular_ ? -HUGE_VAL : 0;
+  for (int i = 0; i < lu_.rows_ && !singular_; ++i) {
+    det_ *= lu_.At(i, i);
+    log_abs_det_ += std::log(std::abs(lu_.At(i, i)));
+  }
+  singular_ = singular_ ||
+              S21HasNegligiblePivot(lu_.rows_, lu_.matrix_, lu_.stride_, norm);
+}
+
+double S21LU::Determinant() const noexcept { return det_; }
+
+double S21LU::LogAbsDeterminant() const noexcept { return log_abs_det_; }
+
+bool S21LU::IsSingular() const noexcept { return singular_; }
+
+S21Matrix S21LU::Solve(const S21ConstMatrixView& b) const {
+  if (b.Rows() != lu_.rows_ || b.Cols() == 0) {
+    throw std::length_error("different matrix dimensions or no matrix exists");
+  }
+  if (singular_) {
+    throw std::length_error("matrix determinant is 0");
+  }
+  S21Matrix result(b);
+  Substitute(lu_.rows_, result.cols_, lu_.matrix_, lu_.stride_,
+             pivots_.data(), result.matrix_, result.stride_);
+  return result;
+}
+
+S21Matrix S21LU::Inverse() const {
+  std::call_once(inverse_once_, [this] {
+    S21Matrix identity(lu_.rows_, lu_.rows_);
+    for (int i = 0; i < lu_.rows_; ++i) {
+      identity.At(i, i) = 1;
+    }
+    inverse_ = Solve(identity);
+  });
+  return inverse_;
+}
+
+// Right-looking blocked factorization. Each kBlock-wide column panel is
+// factored unblocked, with row swaps applied across the whole row; the block
+// row to its right is solved against the panel's unit lower triangle, and
+// the trailing matrix gets a single rank-kBlock GEMM update, which is where
+// almost all of the work goes and what runs in parallel.
+template <typename T>
+int S21LU::Factor(int n, T* a, int lda, int* pivots) {
+  const auto row = [a, lda](int i) {
+    return a + static_cast<std::ptrdiff_t>(i) * lda;
+  };
+  int sign = 1;
+  bool singular = false;
+  for (int k0 = 0; k0 < n; k0 += kBlock) {
+    const int kb = std::min(kBlock, n - k0);
+    const int k1 = k0 + kb;
+    for (int k = k0; k < k1; ++k) {
+      int pivot = k;
+      for (int i = k + 1; i < n; ++i) {
+        if (std::abs(row(i)[k]) > std::abs(row(pivot)[k])) {
+          pivot = i;
+        }
+      }
+      pivots[k] = pivot;
+      if (pivot != k) {
+        std::swap_ranges(row(k), row(k) + n, row(pivot));
+        sign = -sign;
+      }
+      const T diag = row(k)[k];
+      if (diag == 0.0) {
+        singular = true;
+      } else {
+        const T* row_k = row(k);
+        for (int i = k + 1; i < n; ++i) {
+          T* row_i = row(i);
+          const T factor = row_i[k] / diag;
+          row_i[k] = factor;
+          for (int j = k + 1; j < k1; ++j) {
+            row_i[j] -= factor * row_k[j];
+          }
+        }
+      }
+    }
+    if (k1 < n) {
+      for (int k = k0; k < k1; ++k) {
+        const T* row_k = row(k) + k1;
+        for (int i = k + 1; i < k1; ++i) {
+          const T factor = row(i)[k];
+          T* row_i = row(i) + k1;
+          for (int j = 0; j < n - k1; ++j) {
+            row_i[j] -= factor * row_k[j];
+          }
+        }
+      }
+      S21Gemm(n - k1, n - k1, kb, T{-1}, row(k1) + k0, lda,
+              row(k0) + k1, lda, row(k1) + k1, lda);
+    }
+  }
+  return singular ? 0 : sign;
+}
+
+// Row swaps, then forward substitution with the unit lower triangle and
+// back substitution with the upper one, both by kBlock-row blocks. Each
+// block first takes a GEMM update from the rows already solved, which is
+// where almost all of the work goes and what runs in parallel, and is then
+// solved by row updates across all the right-hand sides at once.
+template <typename T>
+void S21LU::Substitute(int n, int nrhs, const T* lu, int lda,
+                       const int* pivots, T* b, int ldb) {
+  const S21BasicKernels<T>& kernels = S21ActiveKernels<T>();
+  const auto row = [b, ldb](int i) {
+    return b + static_cast<std::ptrdiff_t>(i) * ldb;
+  };
+  const auto lu_row = [lu, lda](int i) {
+    return lu + static_cast<std::ptrdiff_t>(i) * lda;
+  };
+  for (int k = 0; k < n; ++k) {
+    if (pivots[k] != k) {
+      std::swap_ranges(row(k), row(k) + nrhs, row(pivots[k]));
+    }
+  }
+  for (int i0 = 0; i0 < n; i0 += kBlock) {
+    const int i1 = std::min(n, i0 + kBlock);
+    if (i0 > 0) {
+      S21Gemm(i1 - i0, nrhs, i0, T{-1}, lu_row(i0), lda, row(0), ldb,
+              row(i0), ldb);
+    }
+    for (int i = i0 + 1; i < i1; ++i) {
+      for (int k = i0; k < i; ++k) {
+        kernels.axpy(nrhs, -lu_row(i)[k], row(k), row(i));
+      }
+    }
+  }
+  for (int i1 = n; i1 > 0; i1 -= kBlock) {
+    const int i0 = std::max(0, i1 - kBlock);
+    if (i1 < n) {
+      S21Gemm(i1 - i0, nrhs, n - i1, T{-1}, lu_row(i0) + i1, lda, row(i1),
+              ldb, row(i0), ldb);
+    }
+    for (int i = i1 - 1; i >= i0; --i) {
+      for (int k = i + 1; k < i1; ++k) {
+        kernels.axpy(nrhs, -lu_row(i)[k], row(k), row(i));
+      }
+      kernels.scale(nrhs, T{1} / lu_row(i)[i], row(i));
+    }
+  }
+}
+
+// X starts at 0, so the first correction is the plain float solution and
+// every later one solves for the error left in X. Residuals are formed in
+// double from the original A, which is what lets X get past float accuracy
+// as long as A is far enough from singular for float factors to contract
+// the error at all.
+bool S21LU::SolveMixed(int n, int nrhs, const double* a, int lda,
+                       const double* b, int ldb, double* x, int ldx) {
+  constexpr double kTolerance = S21Tolerance<double>() / 100;
+  S21ArenaScope scratch;
+  float* lu = scratch.Allocate<float>(static_cast<long>(n) * n);
+  int* pivots = scratch.Allocate<int>(n);
+  float* correction = scratch.Allocate<float>(static_cast<long>(n) * nrhs);
+  double* residual = scratch.Allocate<double>(static_cast<long>(n) * nrhs);
+  for (int i = 0; i < n; ++i) {
+    std::copy(a + static_cast<std::ptrdiff_t>(i) * lda,
+              a + static_cast<std::ptrdiff_t>(i) * lda + n,
+              lu + static_cast<long>(i) * n);
+  }
+  const float norm = S21MaxAbs(n, n, lu, n);
+  bool contracting = Factor(n, lu, n, pivots) != 0 &&
+                     !S21HasNegligiblePivot(n, lu, n, norm);
+  bool converged = false;
+  double previous = HUGE_VAL;
+  for (int i = 0; i < n; ++i) {
+    std::fill(x + static_cast<std::ptrdiff_t>(i) * ldx,
+              x + static_cast<std::ptrdiff_t>(i) * ldx + nrhs, 0.0);
+  }
+  for (int step = 0; step < kMaxRefinements && contracting && !converged;
+       ++step) {
+    for (int i = 0; i < n; ++i) {
+      std::copy(b + static_cast<std::ptrdiff_t>(i) * ldb,
+                b + static_cast<std::ptrdiff_t>(i) * ldb + nrhs,
+                residual + static_cast<long>(i) * nrhs);
+    }
+    if (step > 0) {
+      S21Gemm(n, nrhs, n, -1.0, a, lda, x, ldx, residual, nrhs);
+    }
+    std::copy(residual, residual + static_cast<long>(n) * nrhs, correction);
+    Substitute(n, nrhs, lu, n, pivots, correction, nrhs);
+    double largest = 0;
+    for (int i = 0; i < n; ++i) {
+      double* x_i = x + static_cast<std::ptrdiff_t>(i) * ldx;
+      const float* correction_i = correction + static_cast<long>(i) * nrhs;
+      for (int j = 0; j < nrhs; ++j) {
+        x_i[j] += correction_i[j];
+        const double size = std::abs(correction_i[j]);
+        if (std::isnan(size) || size > largest) {
+          largest = size;
+        }
+      }
+    }
+    converged = largest <= kTolerance;
+    contracting = largest <= previous / 2;
+    previous = largest;
+  }
+  return converged;
+}
+
+template int S21LU::Factor(int n, double* a, int lda, int* pivots);
+template int S21LU::Factor(int n, float* a, int lda, int* pivots);
+template void S21LU::Substitute(int n, int nrhs, const double* lu, int lda,
+                                const int* pivots, double* b, int ldb);
+template void S21LU::Substitute(int n, int nrhs, const float* lu, int lda,
+                                const int* pivots, float* b, int ldb);
@@ -0,0 +1,67 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_LU_H_
+#define CPP_S21_MATRIXPLUS_SRC_S21_LU_H_
+
+#include <mutex>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// LU factorization with partial pivoting: P * A = L * U, where L is unit
+// lower triangular and U is upper triangular. Both factors are kept packed in
+// a single n x n matrix. Factoring costs O(n^3) once; the determinant is
+// then O(1) and each solve O(n^2) per right-hand side, so one S21LU can
+// answer any number of queries about the same matrix. Queries may run
+// concurrently.
+class S21LU {
+ public:
+  explicit S21LU(const S21ConstMatrixView& other);
+  S21LU(const S21LU&) = delete;
+  S21LU& operator=(const S21LU&) = delete;
+
+  double Determinant() const noexcept;
+  // ln |det A|, which stays finite where the determinant itself overflows
+  // or underflows; -inf if A is singular.
+  double LogAbsDeterminant() const noexcept;
+  // Whether a pivot is negligible against the largest element of A, in
+  // which case Solve() and Inverse() throw like S21Matrix::InverseMatrix().
+  bool IsSingular() const noexcept;
+  // Solution x of A * x = b for every column of b.
+  S21Matrix Solve(const S21ConstMatrixView& b) const;
+  // The inverse is computed by the first call and shared with the
+  // matrices later calls return.
+  S21Matrix Inverse() const;
+
+  // Factors the n x n row-major matrix at a in place, storing the row
+  // swapped with row k in pivots[k]. Returns the sign of the permutation, or
+  // 0 if the matrix is singular. T is double or float.
+  template <typename T>
+  static int Factor(int n, T* a, int lda, int* pivots);
+  // Overwrites the n x nrhs row-major matrix at b, rows ldb apart, with the
+  // solution of A * X = B, given A factored by Factor() into lu and pivots.
+  template <typename T>
+  static void Substitute(int n, int nrhs, const T* lu, int lda,
+                         const int* pivots, T* b, int ldb);
+  // Solves A * X = B for n x n A and n x nrhs B by factoring A in float and
+  // refining X against double residuals until a correction falls below a
+  // hundredth of the EqMatrix() tolerance. Returns false, with x
+  // unspecified, if a float pivot is negligible against the largest element
+  // of A or a correction fails to halve the one before.
+  static bool SolveMixed(int n, int nrhs, const double* a, int lda,
+                         const double* b, int ldb, double* x, int ldx);
+
+ private:
+  // Width of the column panels factored between two trailing updates.
+  static constexpr int kBlock = 64;
+  // Refinement steps SolveMixed() takes before giving up.
+  static constexpr int kMaxRefinements = 10;
+
+  S21Matrix lu_;
+  std::vector<int> pivots_;
+  bool singular_{false};
+  double det_{0};
+  double log_abs_det_{0};
+  mutable std::once_flag inverse_once_;
+  mutable S21Matrix inverse_;
+};
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_LU_H_
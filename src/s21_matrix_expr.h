@@ -0,0 +1,300 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_MATRIX_EXPR_H_
+#define CPP_S21_MATRIXPLUS_SRC_S21_MATRIX_EXPR_H_
+
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_matrix_oop.h"
+
+// Lazy elementwise arithmetic. operator+, operator- and scalar operator*
+// build a tree of expression nodes instead of a matrix; nothing is computed
+// until the tree is assigned to a matrix, which then fills its buffer in a
+// single pass. Every node names its element type Scalar, and operands of
+// different element types do not combine. Every node provides Rows(),
+// Cols() and RowReader(i), whose
+// operator[](j) yields element (i, j) of the result, and ReadsOutside(target),
+// which tells whether evaluating into target would read an element of it
+// other than the one being written, as a transposed view of target does.
+// Such results go through a temporary.
+//
+// Nodes keep references to matrix operands, so an expression has to be
+// assigned before the matrices it was built from go away.
+class S21MatrixExprBase {};
+
+template <typename E>
+class S21MatrixExpr : public S21MatrixExprBase {
+ public:
+  const E& Self() const noexcept { return static_cast<const E&>(*this); }
+};
+
+// Leaf node referring to an existing matrix.
+template <typename T>
+class S21MatrixTerm : public S21MatrixExpr<S21MatrixTerm<T>> {
+ public:
+  using Scalar = T;
+
+  explicit S21MatrixTerm(const S21BasicMatrix<T>& matrix) : matrix_(matrix) {
+    if (matrix.IsEmpty()) {
+      throw std::length_error("no matrix exists");
+    }
+  }
+
+  int Rows() const noexcept { return matrix_.rows_; }
+  int Cols() const noexcept { return matrix_.cols_; }
+  const T* RowReader(int i) const noexcept { return matrix_.Row(i); }
+  bool ReadsOutside(const S21BasicMatrixView<const T>& target) const noexcept;
+
+ private:
+  const S21BasicMatrix<T>& matrix_;
+};
+
+struct S21AddOp {
+  template <typename T>
+  static T Apply(T lhs, T rhs) noexcept {
+    return lhs + rhs;
+  }
+};
+
+struct S21SubOp {
+  template <typename T>
+  static T Apply(T lhs, T rhs) noexcept {
+    return lhs - rhs;
+  }
+};
+
+template <typename L, typename R, typename Op>
+class S21MatrixBinary : public S21MatrixExpr<S21MatrixBinary<L, R, Op>> {
+ public:
+  using Scalar = typename L::Scalar;
+
+  S21MatrixBinary(const L& lhs, const R& rhs) : lhs_(lhs), rhs_(rhs) {
+    if (lhs.Rows() != rhs.Rows() || lhs.Cols() != rhs.Cols()) {
+      throw std::length_error(
+          "different matrix dimensions or no matrix exists");
+    }
+  }
+
+  int Rows() const noexcept { return lhs_.Rows(); }
+  int Cols() const noexcept { return lhs_.Cols(); }
+
+  auto RowReader(int i) const noexcept {
+    return Reader{lhs_.RowReader(i), rhs_.RowReader(i)};
+  }
+  bool ReadsOutside(const S21BasicMatrixView<const Scalar>& target) const
+      noexcept {
+    return lhs_.ReadsOutside(target) || rhs_.ReadsOutside(target);
+  }
+
+ private:
+  struct Reader {
+    decltype(std::declval<const L&>().RowReader(0)) lhs;
+    decltype(std::declval<const R&>().RowReader(0)) rhs;
+    Scalar operator[](int j) const noexcept {
+      return Op::Apply(lhs[j], rhs[j]);
+    }
+  };
+
+  L lhs_;
+  R rhs_;
+};
+
+template <typename E>
+class S21MatrixScaled : public S21MatrixExpr<S21MatrixScaled<E>> {
+ public:
+  using Scalar = typename E::Scalar;
+
+  S21MatrixScaled(const E& expr, Scalar scale) : expr_(expr), scale_(scale) {}
+
+  int Rows() const noexcept { return expr_.Rows(); }
+  int Cols() const noexcept { return expr_.Cols(); }
+
+  auto RowReader(int i) const noexcept {
+    return Reader{expr_.RowReader(i), scale_};
+  }
+  bool ReadsOutside(const S21BasicMatrixView<const Scalar>& target) const
+      noexcept {
+    return expr_.ReadsOutside(target);
+  }
+
+ private:
+  struct Reader {
+    decltype(std::declval<const E&>().RowReader(0)) expr;
+    Scalar scale;
+    Scalar operator[](int j) const noexcept { return expr[j] * scale; }
+  };
+
+  E expr_;
+  Scalar scale_;
+};
+
+// Maps an operand type to the node stored for it: matrices become
+// S21MatrixTerm leaves and expressions are stored as they are. Scalar is the
+// element type of the operand.
+template <typename T, typename = void>
+struct S21ExprOperand {
+  static constexpr bool kValid = false;
+};
+
+template <typename T>
+struct S21ExprOperand<S21BasicMatrix<T>> {
+  static constexpr bool kValid = true;
+  using Scalar = T;
+  using Node = S21MatrixTerm<T>;
+  static Node Make(const S21BasicMatrix<T>& matrix) { return Node(matrix); }
+};
+
+template <typename T>
+struct S21ExprOperand<
+    T, std::enable_if_t<std::is_base_of<S21MatrixExprBase, T>::value>> {
+  static constexpr bool kValid = true;
+  using Scalar = typename T::Scalar;
+  using Node = T;
+  static const Node& Make(const T& expr) { return expr; }
+};
+
+template <typename L, typename R>
+using S21EnableIfOperands = std::enable_if_t<
+    S21ExprOperand<L>::kValid && S21ExprOperand<R>::kValid &&
+    std::is_same<typename S21ExprOperand<L>::Scalar,
+                 typename S21ExprOperand<R>::Scalar>::value>;
+
+template <typename T>
+using S21EnableIfOperand = std::enable_if_t<S21ExprOperand<T>::kValid>;
+
+template <typename L, typename R, typename = S21EnableIfOperands<L, R>>
+S21MatrixBinary<typename S21ExprOperand<L>::Node,
+                typename S21ExprOperand<R>::Node, S21AddOp>
+operator+(const L& lhs, const R& rhs) {
+  return {S21ExprOperand<L>::Make(lhs), S21ExprOperand<R>::Make(rhs)};
+}
+
+template <typename L, typename R, typename = S21EnableIfOperands<L, R>>
+S21MatrixBinary<typename S21ExprOperand<L>::Node,
+                typename S21ExprOperand<R>::Node, S21SubOp>
+operator-(const L& lhs, const R& rhs) {
+  return {S21ExprOperand<L>::Make(lhs), S21ExprOperand<R>::Make(rhs)};
+}
+
+template <typename E, typename = S21EnableIfOperand<E>>
+S21MatrixScaled<typename S21ExprOperand<E>::Node> operator*(
+    const E& expr, typename S21ExprOperand<E>::Scalar scale) {
+  return {S21ExprOperand<E>::Make(expr), scale};
+}
+
+template <typename E, typename = S21EnableIfOperand<E>>
+S21MatrixScaled<typename S21ExprOperand<E>::Node> operator*(
+    typename S21ExprOperand<E>::Scalar scale, const E& expr) {
+  return {S21ExprOperand<E>::Make(expr), scale};
+}
+
+template <typename E>
+using S21EnableIfExpr =
+    std::enable_if_t<std::is_base_of<S21MatrixExprBase, E>::value>;
+
+// A temporary matrix combined with an expression absorbs the result in its
+// own buffer, so the expression is still evaluated in one pass.
+template <typename T, typename E, typename = S21EnableIfExpr<E>>
+S21BasicMatrix<T> operator+(S21BasicMatrix<T>&& lhs, const E& rhs) {
+  lhs += rhs;
+  return std::move(lhs);
+}
+
+template <typename T, typename E, typename = S21EnableIfExpr<E>>
+S21BasicMatrix<T> operator+(const E& lhs, S21BasicMatrix<T>&& rhs) {
+  rhs += lhs;
+  return std::move(rhs);
+}
+
+template <typename T, typename E, typename = S21EnableIfExpr<E>>
+S21BasicMatrix<T> operator-(S21BasicMatrix<T>&& lhs, const E& rhs) {
+  lhs -= rhs;
+  return std::move(lhs);
+}
+
+template <typename T, typename E, typename = S21EnableIfExpr<E>>
+S21BasicMatrix<T> operator-(const E& lhs, S21BasicMatrix<T>&& rhs) {
+  rhs = lhs - rhs;
+  return std::move(rhs);
+}
+
+template <typename T>
+const S21BasicMatrix<T>& S21Evaluate(const S21BasicMatrix<T>& matrix) noexcept {
+  return matrix;
+}
+
+template <typename E>
+S21BasicMatrix<typename E::Scalar> S21Evaluate(const S21MatrixExpr<E>& expr) {
+  return S21BasicMatrix<typename E::Scalar>(expr);
+}
+
+// Comparisons involving an expression evaluate it first.
+template <typename L, typename R, typename = S21EnableIfOperands<L, R>>
+bool operator==(const L& lhs, const R& rhs) {
+  return S21Evaluate(lhs).EqMatrix(S21Evaluate(rhs));
+}
+
+template <typename T>
+template <typename E, typename>
+S21BasicMatrix<T>::S21BasicMatrix(const S21MatrixExpr<E>& expr)
+    : S21BasicMatrix(expr.Self().Rows(), expr.Self().Cols()) {
+  EvaluateExpr(expr.Self());
+}
+
+// Elementwise results depend only on the same element of every operand, so
+// evaluating into a matrix that is itself an operand is safe. A result of
+// another shape, one reading this matrix through a reshaping view, or one
+// replacing a shared buffer is evaluated into a new buffer before the old
+// one goes.
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(const S21MatrixExpr<E>& expr) {
+  const E& self = expr.Self();
+  if (rows_ != self.Rows() || cols_ != self.Cols() || IsEmpty() ||
+      IsShared() || self.ReadsOutside(*this)) {
+    S21BasicMatrix result;
+    result.allocator_ = allocator_;
+    result.rows_ = self.Rows();
+    result.cols_ = self.Cols();
+    result.CreateMatrix();
+    result.EvaluateExpr(self);
+    *this = std::move(result);
+  } else {
+    EvaluateExpr(self);
+  }
+  return *this;
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator+=(
+    const S21MatrixExpr<E>& expr) {
+  return *this = *this + expr.Self();
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator-=(
+    const S21MatrixExpr<E>& expr) {
+  return *this = *this - expr.Self();
+}
+
+template <typename T>
+template <typename E>
+void S21BasicMatrix<T>::EvaluateExpr(const E& expr) noexcept {
+  static_assert(std::is_same<typename E::Scalar, T>::value,
+                "the expression has another element type");
+  if constexpr (S21IsView<E>::value) {
+    expr.CopyTo(matrix_, stride_);
+  } else {
+    for (int i = 0; i < rows_; ++i) {
+      const auto reader = expr.RowReader(i);
+      T* row = Row(i);
+      for (int j = 0; j < cols_; ++j) {
+        row[j] = reader[j];
+      }
+    }
+  }
+}
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_MATRIX_EXPR_H_
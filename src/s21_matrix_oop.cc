@@ -1,37 +1,230 @@
 #include "s21_matrix_oop.h"
 
-S21Matrix::S21Matrix(const int rows, const int cols) noexcept
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "s21_allocator.h"
+#include "s21_arena.h"
+#include "s21_cholesky.h"
+#include "s21_gemm.h"
+#include "s21_lu.h"
+#include "s21_qr.h"
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+#include "s21_transpose.h"
+
+namespace {
+
+// Multiply-adds a pool task should get at least when a loop is split
+// across threads.
+constexpr int kParallelGrain = 1 << 14;
+
+using Int64View = S21BasicMatrixView<const std::int64_t>;
+
+// Fraction-free Gaussian elimination (Bareiss) of the first n columns of an
+// n x cols integer matrix with row stride lda, in place, swapping rows past
+// zero pivots. Every entry it leaves is a minor of the input, so each
+// division is exact, and the updates, done in 128 bits, are exact as long
+// as those minors fit in std::int64_t. Returns the determinant of the
+// leading n x n block; elimination stops at a column without a pivot,
+// which makes it 0.
+std::int64_t Bareiss(int n, int cols, std::int64_t* a, long lda) {
+  const auto row = [a, lda](int i) { return a + i * lda; };
+  std::int64_t previous = 1;
+  int sign = 1;
+  bool singular = false;
+  for (int k = 0; k < n && !singular; ++k) {
+    int pivot = k;
+    while (pivot < n && row(pivot)[k] == 0) {
+      ++pivot;
+    }
+    if (pivot == n) {
+      singular = true;
+    } else {
+      if (pivot != k) {
+        std::swap_ranges(row(k), row(k) + cols, row(pivot));
+        sign = -sign;
+      }
+      const std::int64_t* row_k = row(k);
+      const __int128 diag = row_k[k];
+      S21ParallelFor(k + 1, n, kParallelGrain / cols, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+          std::int64_t* row_i = row(i);
+          const __int128 factor = row_i[k];
+          row_i[k] = 0;
+          for (int j = k + 1; j < cols; ++j) {
+            row_i[j] = static_cast<std::int64_t>(
+                (diag * row_i[j] - factor * row_k[j]) / previous);
+          }
+        }
+      });
+      previous = row_k[k];
+    }
+  }
+  return singular ? 0 : sign * previous;
+}
+
+// Back substitution after Bareiss() has turned [A | B], n x n and n x nrhs,
+// into [U | W] with U = E * A and W = E * B: solves U * Y = det(A) * W for
+// Y = det(A) * inv(A) * B, which by Cramer's rule holds determinants of A
+// with one column replaced by one of B, so each division is exact. Element
+// (k, c) of Y goes to out[k * row_stride + c * col_stride].
+void BareissSubstitute(int n, int nrhs, const std::int64_t* m, long width,
+                       std::int64_t det, std::int64_t* out, long row_stride,
+                       long col_stride) {
+  S21ParallelFor(0, nrhs, kParallelGrain / (n * n), [&](int begin, int end) {
+    S21ArenaScope column_scratch;
+    std::int64_t* y = column_scratch.Allocate<std::int64_t>(n);
+    for (int c = begin; c < end; ++c) {
+      for (int k = n - 1; k >= 0; --k) {
+        const std::int64_t* row_k = m + k * width;
+        __int128 sum = static_cast<__int128>(det) * row_k[n + c];
+        for (int l = k + 1; l < n; ++l) {
+          sum -= static_cast<__int128>(row_k[l]) * y[l];
+        }
+        y[k] = static_cast<std::int64_t>(sum / row_k[k]);
+        out[k * row_stride + c * col_stride] = y[k];
+      }
+    }
+  });
+}
+
+// Eliminates [A | B] into scratch and returns det(A), leaving the
+// eliminated rows width apart at *m.
+std::int64_t BareissAugmented(const Int64View& a, const Int64View& b,
+                              S21ArenaScope* scratch, std::int64_t** m,
+                              long* width) {
+  const int n = a.Rows();
+  *width = n + b.Cols();
+  *m = scratch->Allocate<std::int64_t>(n * *width);
+  a.CopyTo(*m, *width);
+  b.CopyTo(*m + n, *width);
+  return Bareiss(n, static_cast<int>(*width), *m, *width);
+}
+
+// Cofactors of an n x n integer matrix, exactly, into out with row stride
+// ld. For a nonsingular matrix, BareissSubstitute() with B = I gives
+// det(A) * inv(A) = adj(A), the transposed cofactors. A singular matrix
+// takes one elimination per cofactor instead.
+void ExactComplements(const Int64View& source, std::int64_t* out, long ld) {
+  const int n = source.Rows();
+  S21ArenaScope scratch;
+  std::int64_t* identity = scratch.Allocate<std::int64_t>(n * n);
+  for (int i = 0; i < n; ++i) {
+    std::fill(identity + i * n, identity + (i + 1) * n, 0);
+    identity[i * n + i] = 1;
+  }
+  std::int64_t* m = nullptr;
+  long width = 0;
+  const std::int64_t det = BareissAugmented(
+      source, Int64View(identity, n, n, n, 1), &scratch, &m, &width);
+  const int grain = kParallelGrain / (n * n);
+  if (det != 0) {
+    BareissSubstitute(n, n, m, width, det, out, 1, ld);
+  } else {
+    S21ParallelFor(0, n, grain / n, [&](int begin, int end) {
+      S21ArenaScope minor_scratch;
+      std::int64_t* minor =
+          minor_scratch.Allocate<std::int64_t>((n - 1) * (n - 1));
+      for (int i = begin; i < end; ++i) {
+        for (int j = 0; j < n; ++j) {
+          source.Minor(i, j).CopyTo(minor, n - 1);
+          const std::int64_t cofactor = Bareiss(n - 1, n - 1, minor, n - 1);
+          out[i * ld + j] = (i + j) % 2 ? -cofactor : cofactor;
+        }
+      }
+    });
+  }
+}
+
+// Copies a positive-definite source into scratch, factors it by Cholesky
+// and returns L, storing det A, the squared product of its diagonal, in
+// det. Throws if the source is not positive definite.
+template <typename T>
+const T* CholeskyFactor(const S21BasicMatrixView<const T>& source,
+                        S21ArenaScope* scratch, T* det) {
+  const int n = source.Rows();
+  T* l = scratch->Allocate<T>(static_cast<long>(n) * n);
+  source.CopyTo(l, n);
+  if (!S21Cholesky::Factor(n, l, n)) {
+    throw std::length_error("the matrix is not positive definite");
+  }
+  *det = 1;
+  for (int i = 0; i < n; ++i) {
+    *det *= l[static_cast<long>(i) * n + i] * l[static_cast<long>(i) * n + i];
+  }
+  return l;
+}
+
+}  // namespace
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const int rows, const int cols) noexcept
     : rows_(rows), cols_(cols), matrix_(nullptr) {
   if (rows > 0 && cols > 0) {
     CreateMatrix();
   }
 }
 
-S21Matrix::S21Matrix(const S21Matrix& other) noexcept
-    : rows_(other.rows_), cols_(other.cols_), matrix_(nullptr) {
-  if (other.matrix_) {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const int rows, const int cols,
+                                  S21MatrixAllocator& allocator) noexcept
+    : rows_(rows), cols_(cols), matrix_(nullptr), allocator_(&allocator) {
+  if (rows > 0 && cols > 0) {
+    CreateMatrix();
+  }
+}
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix& other) noexcept
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      matrix_(nullptr),
+      allocator_(other.allocator_) {
+  if (other.IsShareable()) {
+    ShareMatrix(other);
+  } else if (other.matrix_) {
     CreateMatrix();
     CopyMatrix(other.rows_, other.cols_, other);
   }
 }
 
-S21Matrix::S21Matrix(S21Matrix&& other) noexcept {
-  std::swap(rows_, other.rows_);
-  std::swap(cols_, other.cols_);
-  std::swap(matrix_, other.matrix_);
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(S21BasicMatrix&& other) noexcept {
+  StealMatrix(other);
 }
 
-S21Matrix::~S21Matrix() noexcept { DeleteMatrix(); }
+template <typename T>
+S21BasicMatrix<T>::~S21BasicMatrix() noexcept {
+  DeleteMatrix();
+}
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const ConstView& view) noexcept
+    : S21BasicMatrix(view.Rows(), view.Cols()) {
+  view.CopyTo(matrix_, stride_);
+}
 
-bool S21Matrix::EqMatrix(const S21Matrix& other) const noexcept {
+template <typename T>
+bool S21BasicMatrix<T>::EqMatrix(const S21BasicMatrix& other) const noexcept {
+  return EqMatrix(ConstView(other));
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::EqMatrix(const ConstView& other) const noexcept {
   bool error = true;
-  if (other.cols_ == cols_ && other.rows_ == rows_ && matrix_ &&
-      other.matrix_) {
-    for (int i = 0; i < rows_ && error; ++i) {
-      for (int j = 0; j < cols_ && error; ++j) {
-        if (!(std::abs(other.matrix_[i][j] - matrix_[i][j]) < 1e-7))
-          error = false;
+  if (other.cols_ == cols_ && other.rows_ == rows_ && !IsEmpty()) {
+    const S21BasicKernels<T>& kernels = S21ActiveKernels<T>();
+    if (IsContiguous() && other.IsContiguous()) {
+      error = kernels.equal(Size(), other.data_, matrix_, S21Tolerance<T>());
+    } else if (other.HasDenseRows()) {
+      for (int i = 0; i < rows_ && error; ++i) {
+        error = kernels.equal(cols_, other.RowPtr(i), Row(i),
+                              S21Tolerance<T>());
       }
+    } else {
+      error = other.EqMatrix(*this);
     }
   } else {
     error = false;
@@ -39,335 +232,986 @@ bool S21Matrix::EqMatrix(const S21Matrix& other) const noexcept {
   return error;
 }
 
-void S21Matrix::SumMatrix(const S21Matrix& other) {
-  if (rows_ != other.rows_ || cols_ != other.cols_ || !matrix_ ||
-      !other.matrix_) {
+template <typename T>
+void S21BasicMatrix<T>::SumMatrix(const S21BasicMatrix& other) {
+  SumMatrix(ConstView(other));
+}
+
+template <typename T>
+void S21BasicMatrix<T>::SumMatrix(const ConstView& other) {
+  if (rows_ != other.rows_ || cols_ != other.cols_ || IsEmpty()) {
     throw std::length_error("different matrix dimensions or no matrix exists");
   }
   SumSubMatrix(1, other);
 }
 
-void S21Matrix::SubMatrix(const S21Matrix& other) {
-  if (rows_ != other.rows_ || cols_ != other.cols_ || !matrix_ ||
-      !other.matrix_) {
+template <typename T>
+void S21BasicMatrix<T>::SubMatrix(const S21BasicMatrix& other) {
+  SubMatrix(ConstView(other));
+}
+
+template <typename T>
+void S21BasicMatrix<T>::SubMatrix(const ConstView& other) {
+  if (rows_ != other.rows_ || cols_ != other.cols_ || IsEmpty()) {
     throw std::length_error("different matrix dimensions or no matrix exists");
   }
   SumSubMatrix(-1, other);
 }
 
-void S21Matrix::MulNumber(const double num) {
-  if (!matrix_) {
+template <typename T>
+void S21BasicMatrix<T>::MulNumber(const T num) {
+  if (IsEmpty()) {
     throw std::length_error("no matrix exists");
   }
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] *= num;
+  Detach();
+  const S21BasicKernels<T>& kernels = S21ActiveKernels<T>();
+  if (IsContiguous()) {
+    kernels.scale(Size(), num, matrix_);
+  } else {
+    for (int i = 0; i < rows_; ++i) {
+      kernels.scale(cols_, num, Row(i));
     }
   }
 }
 
-void S21Matrix::MulMatrix(const S21Matrix& other) {
-  if (cols_ != other.rows_ || !matrix_ || !other.matrix_) {
-    throw std::length_error(
-        "the number of columns of the first matrix is not equal to the "
-        "number "
-        "of rows of the second matrix or no matrix exists");
-  }
-  S21Matrix tmp = S21Matrix(rows_, other.cols_);
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < other.cols_; ++j) {
-      for (int k = 0; k < cols_; ++k) {
-        tmp.matrix_[i][j] += matrix_[i][k] * other.matrix_[k][j];
-      }
-    }
-  }
-  cols_ = other.cols_;
-  std::swap(matrix_, tmp.matrix_);
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrix& other) {
+  MulMatrix(ConstView(other));
 }
 
-S21Matrix S21Matrix::Transpose() {
-  if (!matrix_) {
-    throw std::length_error("no matrix exists");
-  }
-  S21Matrix tmp = S21Matrix(cols_, rows_);
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      tmp.matrix_[j][i] = matrix_[i][j];
-    }
-  }
-  return tmp;
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const ConstView& other) {
+  *this = *this * other;
 }
 
-S21Matrix S21Matrix::CalcComplements() {
-  if (rows_ != cols_ || !matrix_) {
-    throw std::length_error("the matrix is not square or no matrix exists");
-  }
-  S21Matrix result_matrix = CalcCompHelper();
-  return result_matrix;
+template <typename T>
+S21BasicMatrixView<const T> S21BasicMatrix<T>::Transpose() const& {
+  return ConstView(*this).Transpose();
 }
 
-double S21Matrix::Determinant() const {
-  if (rows_ != cols_ || !matrix_) {
-    throw std::length_error("the matrix is not square or no matrix exists");
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Transpose() && {
+  S21BasicMatrix result;
+  if (!IsEmpty() && rows_ == cols_) {
+    TransposeInPlace();
+    result.StealMatrix(*this);
+  } else {
+    result = ConstView(*this).Transpose();
   }
-  return DetermHelper();
+  return result;
 }
 
-S21Matrix S21Matrix::InverseMatrix() {
-  if (!matrix_) {
+template <typename T>
+void S21BasicMatrix<T>::TransposeInPlace() {
+  if (IsEmpty()) {
     throw std::length_error("no matrix exists");
   }
-  double det = Determinant();
-  S21Matrix tmp;
-  S21Matrix matrix_resul;
-  if (fabs(det) < 1e-7) {
-    throw std::length_error("matrix determinant is 0");
-  }
-  if (rows_ == 1) {
-    matrix_resul = S21Matrix(1, 1);
-    matrix_resul.matrix_[0][0] = 1 / matrix_[0][0];
-
+  Detach();
+  if (rows_ == cols_) {
+    S21TransposeSquareInPlace(rows_, matrix_, stride_);
   } else {
-    tmp = CalcComplements();
-    matrix_resul = tmp.Transpose();
-    matrix_resul.MulNumber(1.0 / det);
+    for (int i = 1; i < rows_ && !IsContiguous(); ++i) {
+      std::memmove(matrix_ + static_cast<std::ptrdiff_t>(i) * cols_, Row(i),
+                   sizeof(T) * cols_);
+    }
+    S21TransposeInPlace(rows_, cols_, matrix_);
+    std::swap(rows_, cols_);
+    stride_ = cols_;
   }
-  return matrix_resul;
 }
 
-S21Matrix S21Matrix::operator+(const S21Matrix& other) {
-  S21Matrix tmp = S21Matrix(*this);
-  tmp += other;
-  return tmp;
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::CalcComplements() {
+  return ConstView(*this).CalcComplements();
 }
 
-S21Matrix S21Matrix::operator-(const S21Matrix& other) {
-  S21Matrix tmp = S21Matrix(*this);
-  tmp -= other;
-  return tmp;
+template <typename T>
+T S21BasicMatrix<T>::Determinant(S21Structure structure) const {
+  return ConstView(*this).Determinant(structure);
 }
 
-S21Matrix S21Matrix::operator*(const S21Matrix& other) {
-  S21Matrix tmp = S21Matrix(*this);
-  tmp *= other;
-  return tmp;
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::InverseMatrix(S21Structure structure) {
+  return ConstView(*this).InverseMatrix(structure);
 }
 
-S21Matrix S21Matrix::operator*(const double other) {
-  S21Matrix tmp = S21Matrix(*this);
-  tmp *= other;
-  return tmp;
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Solve(const ConstView& b,
+                                           S21Precision precision) const {
+  return ConstView(*this).Solve(b, precision);
 }
 
-S21Matrix operator*(const double other, S21Matrix& tmp) {
-  tmp *= other;
-  return tmp;
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Solve(const ConstView& b,
+                                           S21Structure structure) const {
+  return ConstView(*this).Solve(b, structure);
 }
 
-bool S21Matrix::operator==(const S21Matrix& other) { return EqMatrix(other); }
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::LeastSquares(const ConstView& b) const {
+  return ConstView(*this).LeastSquares(b);
+}
 
-S21Matrix& S21Matrix::operator=(S21Matrix&& other) {
+template <typename T>
+S21BasicMatrix<T> operator*(const S21BasicMatrixView<const T>& lhs,
+                            const S21BasicMatrixView<const T>& rhs) {
+  if (lhs.Cols() != rhs.Rows() || lhs.Rows() == 0 || rhs.Rows() == 0) {
+    throw std::length_error(
+        "the number of columns of the first matrix is not equal to the "
+        "number "
+        "of rows of the second matrix or no matrix exists");
+  }
+  S21BasicMatrix<T> result(lhs.Rows(), rhs.Cols());
+  S21ArenaScope scratch;
+  int lda = 0, ldb = 0;
+  bool trans_a = false, trans_b = false;
+  const T* a = S21BasicMatrix<T>::GemmOperand(lhs, &scratch, &lda, &trans_a);
+  const T* b = S21BasicMatrix<T>::GemmOperand(rhs, &scratch, &ldb, &trans_b);
+  S21Gemm(trans_a, trans_b, lhs.Rows(), rhs.Cols(), lhs.Cols(), T{1}, a,
+          lda, b, ldb, result.matrix_, result.stride_);
+  return result;
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::operator==(const S21BasicMatrix& other) const {
+  return EqMatrix(other);
+}
+
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(S21BasicMatrix&& other) {
   if (this != &other) {
     DeleteMatrix();
-    std::swap(rows_, other.rows_);
-    std::swap(cols_, other.cols_);
-    std::swap(matrix_, other.matrix_);
+    StealMatrix(other);
   }
   return *this;
 }
 
-S21Matrix& S21Matrix::operator=(const S21Matrix& other) {
-  if (this != &other) {
-    DeleteMatrix();
-    rows_ = other.rows_;
-    cols_ = other.cols_;
-    CreateMatrix();
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(const S21BasicMatrix& other) {
+  if (this != &other && other.IsShareable()) {
+    if (matrix_ != other.matrix_) {
+      DeleteMatrix();
+      ShareMatrix(other);
+    } else {
+      // Resizing does not copy, so a matrix sharing the buffer may have
+      // another shape.
+      rows_ = other.rows_;
+      cols_ = other.cols_;
+    }
+  } else if (this != &other) {
+    if (rows_ != other.rows_ || cols_ != other.cols_ || !matrix_ ||
+        !other.matrix_) {
+      DeleteMatrix();
+      rows_ = other.rows_;
+      cols_ = other.cols_;
+      CreateMatrix();
+    }
+    Detach();
     CopyMatrix(rows_, cols_, other);
   }
   return *this;
 }
 
-S21Matrix& S21Matrix::operator+=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator+=(const S21BasicMatrix& other) {
   SumMatrix(other);
   return *this;
 }
 
-S21Matrix& S21Matrix::operator-=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator-=(const S21BasicMatrix& other) {
   SubMatrix(other);
   return *this;
 }
 
-S21Matrix& S21Matrix::operator*=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator*=(const S21BasicMatrix& other) {
   MulMatrix(other);
   return *this;
 }
 
-S21Matrix& S21Matrix::operator*=(const double other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator*=(const T other) {
   MulNumber(other);
   return *this;
 }
 
-double& S21Matrix::operator()(int i, int j) {
-  if (rows_ <= i || cols_ <= j || i < 0 || j < 0 || !matrix_) {
+template <typename T>
+T& S21BasicMatrix<T>::operator()(int i, int j) {
+  if (rows_ <= i || cols_ <= j || i < 0 || j < 0) {
     throw std::length_error("index is outside the matrix or no matrix exists");
   }
-  return matrix_[i][j];
+  Pin();
+  return At(i, j);
 }
 
-double S21Matrix::operator()(int i, int j) const {
-  if (rows_ <= i || cols_ <= j || i < 0 || j < 0 || !matrix_) {
+template <typename T>
+T S21BasicMatrix<T>::operator()(int i, int j) const {
+  if (rows_ <= i || cols_ <= j || i < 0 || j < 0) {
     throw std::length_error("index is outside the matrix or no matrix exists");
   }
-  return matrix_[i][j];
+  return At(i, j);
 }
 
-void S21Matrix::MutateRows(int rows) noexcept {
-  if (rows != rows_ && rows >= 0) {
-    S21Matrix tmp = *this;
+template <typename T>
+void S21BasicMatrix<T>::MutateRows(int rows) noexcept {
+  if (rows > rows_ && cols_ > 0) {
+    // A shared buffer is copied straight into the grown shape; its spare
+    // rows may not be written in place.
+    if (!matrix_ || IsShared() || cols_ > stride_ ||
+        static_cast<std::size_t>(rows) * stride_ > capacity_) {
+      Reallocate(std::max(rows, 2 * RowCapacity()), std::max(cols_, stride_));
+    }
+    for (int i = std::max(rows_, 0); i < rows; ++i) {
+      std::memset(Row(i), 0, sizeof(T) * cols_);
+    }
+    rows_ = rows;
+  } else if (rows == 0) {
+    const int cols = cols_;
     DeleteMatrix();
-    cols_ = tmp.cols_;
+    cols_ = cols;
+  } else if (rows > 0) {
     rows_ = rows;
-    CreateMatrix();
-    CopyMatrix(rows, cols_, tmp);
   }
 }
 
-void S21Matrix::MutateCols(int cols) noexcept {
-  if (cols != cols_ && cols >= 0) {
-    S21Matrix tmp = *this;
+template <typename T>
+void S21BasicMatrix<T>::MutateCols(int cols) noexcept {
+  if (cols > cols_ && rows_ > 0) {
+    if (!matrix_ || IsShared() || cols > stride_) {
+      Reallocate(std::max(rows_, RowCapacity()), std::max(cols, stride_));
+    }
+    const int kept = std::max(cols_, 0);
+    for (int i = 0; i < rows_; ++i) {
+      std::memset(Row(i) + kept, 0, sizeof(T) * (cols - kept));
+    }
+    cols_ = cols;
+  } else if (cols == 0) {
+    const int rows = rows_;
     DeleteMatrix();
-    rows_ = tmp.rows_;
+    rows_ = rows;
+  } else if (cols > 0) {
     cols_ = cols;
-    CreateMatrix();
-    CopyMatrix(rows_, cols, tmp);
   }
 }
 
-int S21Matrix::AccessRows() const noexcept { return rows_; }
+template <typename T>
+int S21BasicMatrix<T>::AccessRows() const noexcept { return rows_; }
 
-int S21Matrix::AccessCols() const noexcept { return cols_; }
+template <typename T>
+int S21BasicMatrix<T>::AccessCols() const noexcept { return cols_; }
+
+template <typename T>
+void S21BasicMatrix<T>::Reserve(int rows, int cols) {
+  if (rows < 0 || cols < 0) {
+    throw std::length_error("the capacity is negative");
+  }
+  const int stride = std::max(cols, stride_);
+  if (rows > 0 && cols > 0 &&
+      (!matrix_ || cols > stride_ ||
+       static_cast<std::size_t>(rows) * stride > capacity_)) {
+    Reallocate(std::max(rows, RowCapacity()), stride);
+  }
+}
+
+template <typename T>
+void S21BasicMatrix<T>::ShrinkToFit() noexcept {
+  if (IsEmpty() && matrix_) {
+    const int rows = rows_, cols = cols_;
+    DeleteMatrix();
+    rows_ = rows;
+    cols_ = cols;
+  } else if (capacity_ > static_cast<std::size_t>(Size())) {
+    Reallocate(rows_, cols_);
+  }
+}
+
+template <typename T>
+void S21BasicMatrix<T>::AppendRow(const T* values) { AppendRows(values, 1); }
+
+template <typename T>
+void S21BasicMatrix<T>::AppendRows(const T* values, int rows) {
+  if (cols_ <= 0 || rows < 0) {
+    throw std::length_error("no matrix exists or the row count is negative");
+  }
+  rows_ = std::max(rows_, 0);
+  // The old buffer stays alive until the values, which may live in it,
+  // have been copied.
+  S21BasicMatrix old;
+  if (!matrix_ || IsShared() || cols_ > stride_ ||
+      static_cast<std::size_t>(rows_ + rows) * stride_ > capacity_) {
+    old = Reallocate(std::max(rows_ + rows, 2 * RowCapacity()),
+                     std::max(cols_, stride_));
+  }
+  for (int i = 0; i < rows; ++i) {
+    std::memcpy(Row(rows_ + i), values + static_cast<std::ptrdiff_t>(i) * cols_,
+                sizeof(T) * cols_);
+  }
+  rows_ += rows;
+}
 
-void S21Matrix::CreateMatrix() noexcept {
+template <typename T>
+void S21BasicMatrix<T>::CreateMatrix() noexcept {
   if (rows_ > 0 && cols_ > 0) {
-    matrix_ = new double* [rows_] {};
-    for (int i = 0; i < rows_; ++i) {
-      matrix_[i] = new double[cols_]{};
+    AllocateBuffer(rows_, cols_);
+    std::memset(matrix_, 0, sizeof(T) * capacity_);
+  }
+}
+
+// Points matrix_ at a new, uninitialized buffer for rows rows of stride
+// elements; this matrix must not hold a buffer.
+template <typename T>
+void S21BasicMatrix<T>::AllocateBuffer(int rows, int stride) noexcept {
+  stride_ = stride;
+  capacity_ = static_cast<std::size_t>(rows) * stride;
+  if (capacity_ <= kSmallSize) {
+    matrix_ = small_;
+  } else {
+    if (!allocator_) {
+      allocator_ = &S21GetMatrixAllocator();
     }
+    matrix_ = reinterpret_cast<T*>(allocator_->Allocate(BufferDoubles()));
   }
 }
 
-void S21Matrix::DeleteMatrix() noexcept {
-  if (matrix_) {
-    for (int i = 0; i < rows_; ++i) {
-      if (matrix_[i]) {
-        delete[] matrix_[i];
-      }
+// Moves the elements to a new buffer for rows rows of stride elements and
+// returns a matrix holding the old buffer, which callers may still read.
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Reallocate(int rows,
+                                                int stride) noexcept {
+  S21BasicMatrix old(std::move(*this));
+  rows_ = old.rows_;
+  cols_ = old.cols_;
+  AllocateBuffer(rows, stride);
+  CopyMatrix(rows_, cols_, old);
+  return old;
+}
+
+// Frees a heap buffer, or gives up this matrix's share of it if other
+// owners remain.
+template <typename T>
+void S21BasicMatrix<T>::DeleteMatrix() noexcept {
+  if (matrix_ && !IsSmall()) {
+    SharedBuffer* shared = shared_.exchange(nullptr, std::memory_order_relaxed);
+    if (!shared ||
+        shared->owners.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      allocator_->Deallocate(reinterpret_cast<double*>(matrix_),
+                             BufferDoubles());
+      delete shared;
     }
-    delete[] matrix_;
   }
   matrix_ = nullptr;
   rows_ = 0;
   cols_ = 0;
+  stride_ = 0;
+  capacity_ = 0;
+  pinned_ = false;
+}
+
+// Takes over the contents of other, which must not be this matrix, and
+// leaves it empty; this matrix must be empty beforehand. Heap buffers change
+// owner, inline ones are copied.
+template <typename T>
+void S21BasicMatrix<T>::StealMatrix(S21BasicMatrix& other) noexcept {
+  rows_ = other.rows_;
+  cols_ = other.cols_;
+  stride_ = other.stride_;
+  capacity_ = other.capacity_;
+  if (other.IsSmall()) {
+    matrix_ = small_;
+    std::memcpy(small_, other.small_, sizeof(T) * capacity_);
+  } else if (other.matrix_) {
+    matrix_ = other.matrix_;
+    allocator_ = other.allocator_;
+    pinned_ = other.pinned_;
+    shared_.store(other.shared_.exchange(nullptr, std::memory_order_relaxed),
+                  std::memory_order_relaxed);
+    other.matrix_ = nullptr;
+  }
+  other.DeleteMatrix();
+}
+
+// Makes this matrix, which must be empty, another owner of the heap buffer
+// of other. The owner count is attached by the first copy; concurrent first
+// copies of one matrix race to attach theirs and the losers drop their own.
+template <typename T>
+void S21BasicMatrix<T>::ShareMatrix(const S21BasicMatrix& other) noexcept {
+  SharedBuffer* shared = other.shared_.load(std::memory_order_acquire);
+  if (!shared) {
+    SharedBuffer* created = new SharedBuffer{{1}};
+    if (other.shared_.compare_exchange_strong(shared, created,
+                                              std::memory_order_acq_rel,
+                                              std::memory_order_acquire)) {
+      shared = created;
+    } else {
+      delete created;
+    }
+  }
+  shared->owners.fetch_add(1, std::memory_order_relaxed);
+  rows_ = other.rows_;
+  cols_ = other.cols_;
+  stride_ = other.stride_;
+  capacity_ = other.capacity_;
+  matrix_ = other.matrix_;
+  allocator_ = other.allocator_;
+  shared_.store(shared, std::memory_order_relaxed);
+}
+
+// Every member that writes the elements calls this first. A buffer with
+// other owners is copied and this matrix moves to the copy, which has the
+// same stride and row capacity, so capacity checks made before detaching
+// still hold; a buffer whose other owners have all gone is simply taken
+// back.
+template <typename T>
+void S21BasicMatrix<T>::Detach() noexcept {
+  SharedBuffer* shared = shared_.load(std::memory_order_relaxed);
+  if (shared && shared->owners.load(std::memory_order_acquire) == 1) {
+    shared_.store(nullptr, std::memory_order_relaxed);
+    delete shared;
+  } else if (shared) {
+    S21BasicMatrix copy(0, 0, *allocator_);
+    copy.rows_ = rows_;
+    copy.cols_ = cols_;
+    copy.AllocateBuffer(RowCapacity(), stride_);
+    copy.CopyMatrix(rows_, cols_, *this);
+    DeleteMatrix();
+    StealMatrix(copy);
+  }
+}
+
+// Detaches the buffer and keeps it unshared for as long as this matrix
+// holds it, for members that hand out writable references into it. Heap
+// buffers keep their address when moved, so moves keep the pin too.
+template <typename T>
+void S21BasicMatrix<T>::Pin() noexcept {
+  Detach();
+  pinned_ = !IsSmall();
+}
+
+template <typename T>
+void S21BasicMatrix<T>::CopyMatrix(const int rows, const int cols,
+                                   const S21BasicMatrix& other) noexcept {
+  const int copy_rows = std::min(rows, other.rows_);
+  const int copy_cols = std::min(cols, other.cols_);
+  if (matrix_ && other.matrix_ && copy_rows > 0 && copy_cols > 0) {
+    if (copy_cols == stride_ && stride_ == other.stride_) {
+      std::memcpy(matrix_, other.matrix_, sizeof(T) * copy_rows * stride_);
+    } else {
+      for (int i = 0; i < copy_rows; ++i) {
+        std::memcpy(Row(i), other.Row(i), sizeof(T) * copy_cols);
+      }
+    }
+  }
 }
 
-void S21Matrix::CopyMatrix(const int rows, const int cols,
-                           const S21Matrix& other) noexcept {
-  bool flag_rows = true;
-  bool flag_cols = true;
-  for (int i = 0; i < rows && flag_rows && other.rows_ > 0; ++i) {
-    for (int j = 0; j < cols && flag_cols && other.cols_ > 0; ++j) {
-      if (i == other.rows_) {
-        flag_rows = false;
-      } else if (j == other.cols_) {
-        flag_cols = false;
-      } else {
-        matrix_[i][j] = other.matrix_[i][j];
+template <typename T>
+void S21BasicMatrix<T>::SumSubMatrix(const int tmp,
+                                     const ConstView& other) noexcept {
+  Detach();
+  const S21BasicKernels<T>& kernels = S21ActiveKernels<T>();
+  const auto op = tmp < 0 ? kernels.sub : kernels.add;
+  if (other.ReadsOutside(*this)) {
+    SumSubMatrix(tmp, S21BasicMatrix(other));
+  } else if (IsContiguous() && other.IsContiguous()) {
+    op(Size(), other.data_, matrix_);
+  } else if (other.HasDenseRows()) {
+    for (int i = 0; i < rows_; ++i) {
+      op(cols_, other.RowPtr(i), Row(i));
+    }
+  } else if (tmp < 0) {
+    for (int i = 0; i < rows_; ++i) {
+      T* row = Row(i);
+      for (int j = 0; j < cols_; ++j) {
+        row[j] -= other.At(i, j);
+      }
+    }
+  } else {
+    for (int i = 0; i < rows_; ++i) {
+      T* row = Row(i);
+      for (int j = 0; j < cols_; ++j) {
+        row[j] += other.At(i, j);
       }
     }
   }
 }
 
-void S21Matrix::Minor(S21Matrix* A, int colums, int rows) const noexcept {
-  A->MutateRows(rows_ - 1);
-  A->MutateCols(cols_ - 1);
-  for (int i = 0, c = 0, r = 0; i < A->rows_; ++i) {
-    if (rows == i) {
-      r = 1;
+// view as a GEMM operand. Views whose rows or columns are evenly spaced
+// runs are read in place, the latter as the transpose of their storage;
+// anything else is packed into scratch first.
+template <typename T>
+const T* S21BasicMatrix<T>::GemmOperand(const ConstView& view,
+                                        S21ArenaScope* scratch, int* ld,
+                                        bool* trans) {
+  const T* result = view.data_;
+  const bool no_skip = view.skip_row_ == ConstView::kNoSkip &&
+                       view.skip_col_ == ConstView::kNoSkip;
+  *trans = no_skip && view.col_stride_ != 1 && view.row_stride_ == 1;
+  *ld = static_cast<int>(*trans ? view.col_stride_ : view.row_stride_);
+  if (!no_skip || (view.col_stride_ != 1 && !*trans)) {
+    T* packed =
+        scratch->Allocate<T>(static_cast<long>(view.rows_) * view.cols_);
+    view.CopyTo(packed, view.cols_);
+    result = packed;
+    *ld = view.cols_;
+  }
+  return result;
+}
+
+// Up to 3x3 the cofactors are written out directly. Larger matrices go
+// through one LU factorization with complete pivoting, P * A * Q = L * U,
+// which pushes any rank deficiency into the last pivot. Splitting
+// U = [U11 u; 0 d] gives adj(U) = [d * det(U11) * inv(U11), -det(U11) *
+// inv(U11) * u; 0, det(U11)], which stays finite when d == 0, and
+// adj(A) = det(P) * det(Q) * Q * adj(U) * inv(L) * P. If two or more pivots
+// vanish, every cofactor is 0. Integer matrices skip the LU and go through
+// ExactComplements().
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::CalcCompHelper(const ConstView& source) {
+  const int n = source.rows_;
+  S21BasicMatrix result_matrix(n, n);
+  if (n == 1) {
+    result_matrix.At(0, 0) = source.At(0, 0);
+  } else if (n == 2) {
+    result_matrix.At(0, 0) = source.At(1, 1);
+    result_matrix.At(0, 1) = -source.At(1, 0);
+    result_matrix.At(1, 0) = -source.At(0, 1);
+    result_matrix.At(1, 1) = source.At(0, 0);
+  } else if (n == 3) {
+    for (int i = 0; i < 3; ++i) {
+      const int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+      for (int j = 0; j < 3; ++j) {
+        const int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+        result_matrix.At(i, j) = source.At(i1, j1) * source.At(i2, j2) -
+                                 source.At(i1, j2) * source.At(i2, j1);
+      }
     }
-    for (int j = 0; j < A->cols_; ++j) {
-      if (colums == j) {
-        c = 1;
+  } else if constexpr (std::is_integral<T>::value) {
+    ExactComplements(source, result_matrix.matrix_, result_matrix.stride_);
+  } else {
+    // The factors are built in the result's buffer, which is only
+    // overwritten once the adjugate is complete.
+    S21BasicMatrix& lu = result_matrix;
+    source.CopyTo(lu.matrix_, lu.stride_);
+    S21ArenaScope scratch;
+    int* row_perm = scratch.Allocate<int>(n + 1);
+    int* col_perm = scratch.Allocate<int>(n + 1);
+    const int rank = lu.CompletePivotLU(row_perm, col_perm);
+    if (rank < n - 1) {
+      std::memset(result_matrix.matrix_, 0, sizeof(T) * lu.Size());
+    } else {
+      const int m = n - 1;
+      const T sign = row_perm[n] * col_perm[n];
+      T* adj = scratch.Allocate<T>(lu.Size());
+      std::memset(adj, 0, sizeof(T) * lu.Size());
+      const auto adj_row = [adj, n](int i) {
+        return adj + static_cast<long>(i) * n;
+      };
+      T det11 = 1;
+      for (int i = m - 1; i >= 0; --i) {
+        T* row_i = adj_row(i);
+        const T* lu_i = lu.Row(i);
+        for (int k = i + 1; k < m; ++k) {
+          const T* row_k = adj_row(k);
+          for (int j = k; j < m; ++j) {
+            row_i[j] -= lu_i[k] * row_k[j];
+          }
+        }
+        row_i[i] += 1;
+        for (int j = i; j < m; ++j) {
+          row_i[j] /= lu_i[i];
+        }
+        det11 *= lu_i[i];
+      }
+      const T det = det11 * lu.At(m, m);
+      for (int i = 0; i < m; ++i) {
+        T* row_i = adj_row(i);
+        T dot = 0;
+        for (int k = i; k < m; ++k) {
+          dot += row_i[k] * lu.At(k, m);
+        }
+        row_i[m] = -det11 * dot;
+        for (int j = i; j < m; ++j) {
+          row_i[j] *= det;
+        }
+      }
+      adj_row(m)[m] = det11;
+      for (int i = 0; i < n; ++i) {
+        T* row_i = adj_row(i);
+        for (int k = n - 1; k > 0; --k) {
+          const T* lu_k = lu.Row(k);
+          for (int j = 0; j < k; ++j) {
+            row_i[j] -= row_i[k] * lu_k[j];
+          }
+        }
+      }
+      for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+          result_matrix.At(row_perm[i], col_perm[j]) = sign * adj_row(j)[i];
+        }
       }
-      A->matrix_[i][j] = matrix_[i + r][j + c];
     }
-    c = 0;
   }
+  return result_matrix;
 }
 
-double S21Matrix::DeterminantMinor(int row, int colum) noexcept {
-  double result = 0;
-  S21Matrix temp = S21Matrix();
-  if (rows_ == 1) {
-    result = matrix_[0][0];
+template <typename T>
+T S21BasicMatrix<T>::DetermHelper(const ConstView& source) {
+  const int n = source.rows_;
+  T result = 0;
+  if (n == 1) {
+    result = source.At(0, 0);
+  } else if (n == 2) {
+    result = source.At(0, 0) * source.At(1, 1) -
+             source.At(1, 0) * source.At(0, 1);
+  } else if (n == 3) {
+    int sign = 1;
+    for (int i = 0; i < n; ++i) {
+      const int c0 = i == 0 ? 1 : 0;
+      const int c1 = i == 2 ? 1 : 2;
+      result += sign * source.At(0, i) *
+                (source.At(1, c0) * source.At(2, c1) -
+                 source.At(2, c0) * source.At(1, c1));
+      sign *= -1;
+    }
+  } else if constexpr (std::is_integral<T>::value) {
+    S21ArenaScope scratch;
+    T* a = scratch.Allocate<T>(static_cast<long>(n) * n);
+    source.CopyTo(a, n);
+    result = Bareiss(n, n, a, n);
   } else {
-    Minor(&temp, colum, row);
-    result = temp.Determinant();
+    S21ArenaScope scratch;
+    T* lu = scratch.Allocate<T>(static_cast<long>(n) * n);
+    int* pivots = scratch.Allocate<int>(n);
+    source.CopyTo(lu, n);
+    result = S21LU::Factor(n, lu, n, pivots);
+    for (int i = 0; i < n && result != 0; ++i) {
+      result *= lu[static_cast<long>(i) * n + i];
+    }
   }
   return result;
 }
 
-void S21Matrix::SumSubMatrix(const int tmp, const S21Matrix& other) noexcept {
-  for (int i = 0; i < other.rows_; ++i) {
-    for (int j = 0; j < other.cols_; ++j) {
-      matrix_[i][j] += other.matrix_[i][j] * tmp;
+template <typename T>
+T S21BasicMatrix<T>::DetermOf(const ConstView& source,
+                              S21Structure structure) {
+  T result = 0;
+  bool factored = false;
+  if constexpr (!std::is_integral<T>::value) {
+    if (structure == S21Structure::kPositiveDefinite) {
+      S21ArenaScope scratch;
+      CholeskyFactor(source, &scratch, &result);
+      factored = true;
     }
   }
+  return factored ? result : DetermHelper(source);
 }
 
-S21Matrix S21Matrix::CalcCompHelper() noexcept {
-  double result_tmp = 0;
-  double tmp_0_0 = 0;
-  double tmp_0_1 = 0;
-  S21Matrix result_matrix = S21Matrix{*this};
-  if (rows_ == 2) {
-    tmp_0_0 = matrix_[0][0];
-    tmp_0_1 = matrix_[0][1];
-    matrix_[0][0] = matrix_[1][1];
-    matrix_[0][1] = matrix_[1][0];
-    matrix_[1][0] = tmp_0_1;
-    matrix_[1][1] = tmp_0_0;
-    for (int i = 0; i < rows_; ++i) {
-      for (int j = 0; j < cols_; ++j) {
-        result_tmp = pow(-1, (i + j)) * matrix_[i][j];
-        result_matrix(i, j) = result_tmp;
+// Floating-point matrices are inverted by elimination, or by substituting
+// the identity into their Cholesky factor when they are known to be
+// positive definite. Integer ones have an integer inverse only for a
+// determinant of 1 or -1, where it is det * adj(A), and otherwise the
+// inverse is refused.
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::InverseOf(const ConstView& source,
+                                               S21Structure structure) {
+  S21BasicMatrix result;
+  if constexpr (std::is_integral<T>::value) {
+    const T det = DetermHelper(source);
+    if (det == 0) {
+      throw std::length_error("matrix determinant is 0");
+    }
+    if (det != 1 && det != -1) {
+      throw std::length_error("the inverse has non-integer elements");
+    }
+    result = CalcCompHelper(source).Transpose();
+    result.MulNumber(det);
+  } else if (structure == S21Structure::kPositiveDefinite) {
+    const int n = source.rows_;
+    S21ArenaScope scratch;
+    T det = 0;
+    const T* l = CholeskyFactor(source, &scratch, &det);
+    if (S21Cholesky::IsSingular(n, l, n)) {
+      throw std::length_error("matrix determinant is 0");
+    }
+    result = S21BasicMatrix(n, n);
+    for (int i = 0; i < n; ++i) {
+      result.At(i, i) = 1;
+    }
+    S21Cholesky::Substitute(n, n, l, n, result.matrix_, result.stride_);
+  } else {
+    result = source;
+    const bool invertible = result.rows_ <= 3 ? result.SmallInverseHelper()
+                                              : result.InverseHelper();
+    if (!invertible) {
+      throw std::length_error("matrix determinant is 0");
+    }
+  }
+  return result;
+}
+
+// Integer systems are solved exactly through BareissSubstitute(). A
+// positive-definite A is factored by Cholesky. Double ones asked for kMixed
+// try S21LU::SolveMixed() first. Otherwise, or if that fails, A is factored
+// by LU in its own precision. The factors are substituted into a copy of B.
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::SolveOf(const ConstView& a,
+                                             const ConstView& b,
+                                             S21Precision precision,
+                                             S21Structure structure) {
+  if (a.Rows() != b.Rows() || b.Cols() == 0) {
+    throw std::length_error("different matrix dimensions or no matrix exists");
+  }
+  const int n = a.Rows();
+  const int nrhs = b.Cols();
+  S21BasicMatrix result(n, nrhs);
+  S21ArenaScope scratch;
+  if constexpr (std::is_integral<T>::value) {
+    T* m = nullptr;
+    long width = 0;
+    const T det = BareissAugmented(a, b, &scratch, &m, &width);
+    if (det == 0) {
+      throw std::length_error("matrix determinant is 0");
+    }
+    BareissSubstitute(n, nrhs, m, width, det, result.matrix_, result.stride_,
+                      1);
+    for (int i = 0; i < n; ++i) {
+      T* row = result.Row(i);
+      for (int j = 0; j < nrhs; ++j) {
+        if (row[j] % det != 0) {
+          throw std::length_error("the solution has non-integer elements");
+        }
+        row[j] /= det;
       }
     }
   } else {
-    for (int i = 0; i < rows_; ++i) {
-      for (int j = 0; j < cols_; ++j) {
-        result_tmp = 0;
-        result_tmp = pow(-1, (i + j)) * DeterminantMinor(i, j);
-        result_matrix(i, j) = result_tmp;
+    bool solved = false;
+    if (structure == S21Structure::kPositiveDefinite) {
+      T det = 0;
+      const T* l = CholeskyFactor(a, &scratch, &det);
+      if (S21Cholesky::IsSingular(n, l, n)) {
+        throw std::length_error("matrix determinant is 0");
       }
+      b.CopyTo(result.matrix_, result.stride_);
+      S21Cholesky::Substitute(n, nrhs, l, n, result.matrix_, result.stride_);
+      solved = true;
+    }
+    if constexpr (std::is_same<T, double>::value) {
+      if (!solved && precision == S21Precision::kMixed) {
+        T* dense_a = scratch.Allocate<T>(static_cast<long>(n) * n);
+        T* dense_b = scratch.Allocate<T>(static_cast<long>(n) * nrhs);
+        a.CopyTo(dense_a, n);
+        b.CopyTo(dense_b, nrhs);
+        solved = S21LU::SolveMixed(n, nrhs, dense_a, n, dense_b, nrhs,
+                                   result.matrix_, result.stride_);
+      }
+    }
+    if (!solved) {
+      T* lu = scratch.Allocate<T>(static_cast<long>(n) * n);
+      int* pivots = scratch.Allocate<int>(n);
+      a.CopyTo(lu, n);
+      const T norm = S21MaxAbs(n, n, lu, n);
+      if (S21LU::Factor(n, lu, n, pivots) == 0 ||
+          S21HasNegligiblePivot(n, lu, n, norm)) {
+        throw std::length_error("matrix determinant is 0");
+      }
+      b.CopyTo(result.matrix_, result.stride_);
+      S21LU::Substitute(n, nrhs, lu, n, pivots, result.matrix_,
+                        result.stride_);
     }
   }
-  return result_matrix;
+  return result;
 }
 
-double S21Matrix::DetermHelper() const noexcept {
-  double result = 0;
-  int sign = 1;
-  S21Matrix temp_d = S21Matrix();
-  if (rows_ == 1) {
-    result = matrix_[0][0];
-  } else if (rows_ == 2) {
-    result = matrix_[0][0] * matrix_[1][1] - matrix_[1][0] * matrix_[0][1];
+// Integer systems go through the normal equations A^T * A * x = A^T * b,
+// which SolveOf() solves exactly. Floating-point ones go to
+// S21QR::LeastSquares().
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::LeastSquaresOf(const ConstView& a,
+                                                    const ConstView& b) {
+  if (a.Rows() != b.Rows() || a.Rows() < a.Cols() || a.Cols() == 0 ||
+      b.Cols() == 0) {
+    throw std::length_error(
+        "different matrix dimensions, fewer rows than columns or no matrix "
+        "exists");
+  }
+  S21BasicMatrix result;
+  if constexpr (std::is_integral<T>::value) {
+    result = SolveOf(a.Transpose() * a, a.Transpose() * b,
+                     S21Precision::kFull, S21Structure::kGeneral);
   } else {
-    for (int i = 0; i < cols_; ++i) {
-      Minor(&temp_d, i, 0);
-      result += sign * matrix_[0][i] * temp_d.DetermHelper();
-      sign *= -1;
+    result = S21BasicMatrix(a.Cols(), b.Cols());
+    if (!S21QR::LeastSquares(a, b, result.matrix_, result.stride_)) {
+      throw std::length_error(
+          "the columns of the matrix are linearly dependent");
     }
   }
   return result;
 }
+
+// Inverts the matrix in place by Gauss-Jordan elimination with partial
+// pivoting. Row swaps are undone as column swaps at the end, so no second
+// buffer is needed. A pivot negligible against the largest element of the
+// original stops the elimination early and false is returned, leaving the
+// contents unspecified. The row updates of each step are spread over the
+// pool.
+template <typename T>
+bool S21BasicMatrix<T>::InverseHelper() {
+  const int n = rows_;
+  const S21BasicKernels<T>& kernels = S21ActiveKernels<T>();
+  S21ArenaScope scratch;
+  int* pivots = scratch.Allocate<int>(n);
+  const T norm = S21MaxAbs(n, n, matrix_, stride_);
+  bool invertible = true;
+  for (int k = 0; k < n && invertible; ++k) {
+    int pivot = k;
+    for (int i = k + 1; i < n; ++i) {
+      if (std::abs(At(i, k)) > std::abs(At(pivot, k))) {
+        pivot = i;
+      }
+    }
+    pivots[k] = pivot;
+    if (pivot != k) {
+      std::swap_ranges(Row(k), Row(k) + n, Row(pivot));
+    }
+    const T diag = At(k, k);
+    invertible = !S21NegligiblePivot(diag, norm, n);
+    if (invertible) {
+      T* row_k = Row(k);
+      row_k[k] = 1;
+      for (int j = 0; j < n; ++j) {
+        row_k[j] /= diag;
+      }
+      S21ParallelFor(0, n, kParallelGrain / n, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+          T* row_i = Row(i);
+          const T factor = row_i[k];
+          if (i != k && factor != 0) {
+            row_i[k] = 0;
+            kernels.axpy(n, -factor, row_k, row_i);
+          }
+        }
+      });
+    }
+  }
+  for (int k = n - 1; k >= 0 && invertible; --k) {
+    if (pivots[k] != k) {
+      for (int i = 0; i < n; ++i) {
+        std::swap(At(i, k), At(i, pivots[k]));
+      }
+    }
+  }
+  return invertible;
+}
+
+// Up to 3x3 the adjugate is written out directly, which is cheaper than
+// elimination and exact for integer input. The matrix counts as singular
+// when its determinant is negligible against the n-th power of its largest
+// element, the scale of a product of n pivots.
+template <typename T>
+bool S21BasicMatrix<T>::SmallInverseHelper() noexcept {
+  const int n = rows_;
+  T a[3][3] = {};
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      a[i][j] = At(i, j);
+    }
+  }
+  const T det = DetermHelper(*this);
+  const T norm = S21MaxAbs(n, n, matrix_, stride_);
+  T scale = 1;
+  for (int i = 0; i < n; ++i) {
+    scale *= norm;
+  }
+  const bool invertible = !S21NegligiblePivot(det, scale, n);
+  if (invertible) {
+    const T inv_det = T{1} / det;
+    if (n == 1) {
+      At(0, 0) = 1 / a[0][0];
+    } else if (n == 2) {
+      At(0, 0) = a[1][1] * inv_det;
+      At(0, 1) = -a[0][1] * inv_det;
+      At(1, 0) = -a[1][0] * inv_det;
+      At(1, 1) = a[0][0] * inv_det;
+    } else {
+      for (int i = 0; i < 3; ++i) {
+        const int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+        for (int j = 0; j < 3; ++j) {
+          const int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+          At(j, i) = (a[i1][j1] * a[i2][j2] - a[i1][j2] * a[i2][j1]) * inv_det;
+        }
+      }
+    }
+  }
+  return invertible;
+}
+
+// Gaussian elimination with complete pivoting, in place. On return
+// row_perm[i] and col_perm[j] give the row and column of the original matrix
+// that ended up at position i and j, and the extra entries row_perm[n] and
+// col_perm[n] hold the signs of the two permutations. Returns the number of
+// nonzero pivots; elimination stops at the first zero one.
+template <typename T>
+int S21BasicMatrix<T>::CompletePivotLU(int* row_perm, int* col_perm) {
+  const int n = rows_;
+  const S21BasicKernels<T>& kernels = S21ActiveKernels<T>();
+  int rank = 0;
+  bool done = false;
+  row_perm[n] = 1;
+  col_perm[n] = 1;
+  for (int i = 0; i < n; ++i) {
+    row_perm[i] = i;
+    col_perm[i] = i;
+  }
+  for (int k = 0; k < n && !done; ++k) {
+    int p = k, q = k;
+    for (int i = k; i < n; ++i) {
+      const T* row_i = Row(i);
+      for (int j = k; j < n; ++j) {
+        if (std::abs(row_i[j]) > std::abs(At(p, q))) {
+          p = i;
+          q = j;
+        }
+      }
+    }
+    if (At(p, q) == 0) {
+      done = true;
+    } else {
+      if (p != k) {
+        std::swap_ranges(Row(k), Row(k) + n, Row(p));
+        std::swap(row_perm[k], row_perm[p]);
+        row_perm[n] = -row_perm[n];
+      }
+      if (q != k) {
+        for (int i = 0; i < n; ++i) {
+          std::swap(At(i, k), At(i, q));
+        }
+        std::swap(col_perm[k], col_perm[q]);
+        col_perm[n] = -col_perm[n];
+      }
+      const T* row_k = Row(k);
+      S21ParallelFor(k + 1, n, kParallelGrain / n, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+          T* row_i = Row(i);
+          const T factor = row_i[k] / row_k[k];
+          row_i[k] = factor;
+          kernels.axpy(n - k - 1, -factor, row_k + k + 1, row_i + k + 1);
+        }
+      });
+      ++rank;
+    }
+  }
+  return rank;
+}
+
+template class S21BasicMatrix<double>;
+template class S21BasicMatrix<float>;
+template class S21BasicMatrix<std::int64_t>;
+template S21BasicMatrix<double> operator*(
+    const S21BasicMatrixView<const double>& lhs,
+    const S21BasicMatrixView<const double>& rhs);
+template S21BasicMatrix<float> operator*(
+    const S21BasicMatrixView<const float>& lhs,
+    const S21BasicMatrixView<const float>& rhs);
+template S21BasicMatrix<std::int64_t> operator*(
+    const S21BasicMatrixView<const std::int64_t>& lhs,
+    const S21BasicMatrixView<const std::int64_t>& rhs);
@@ -1,60 +1,383 @@
 #ifndef CPP_S21_MATRIXPLUS_SRC_S21_MATRIX_OOP_H_
 #define CPP_S21_MATRIXPLUS_SRC_S21_MATRIX_OOP_H_
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+class S21ArenaScope;
+class S21MatrixAllocator;
+template <typename E>
+class S21MatrixExpr;
+template <typename T>
+class S21BasicMatrixView;
+template <typename T>
+class S21BasicMatrix;
+
+using S21Matrix = S21BasicMatrix<double>;
+using S21FloatMatrix = S21BasicMatrix<float>;
+using S21Int64Matrix = S21BasicMatrix<std::int64_t>;
+using S21ConstMatrixView = S21BasicMatrixView<const double>;
+
+template <typename T>
+struct S21IsView : std::false_type {};
+template <typename T>
+struct S21IsView<S21BasicMatrixView<T>> : std::true_type {};
+// Expressions other than views with elements of type T.
+template <typename E, typename T>
+using S21EnableIfExprOf = std::enable_if_t<
+    !S21IsView<E>::value && std::is_same<typename E::Scalar, T>::value>;
+
+// Largest difference EqMatrix() accepts between elements of type T.
+// Integers compare exactly.
+template <typename T>
+constexpr double S21Tolerance() noexcept {
+  return std::is_same<T, float>::value ? 1e-5 : 1e-7;
+}
+
+// Largest magnitude among the elements of the rows x cols matrix at a,
+// rows lda apart.
+template <typename T>
+T S21MaxAbs(int rows, int cols, const T* a, int lda) noexcept {
+  T result = 0;
+  for (int i = 0; i < rows; ++i) {
+    const T* row = a + static_cast<std::ptrdiff_t>(i) * lda;
+    for (int j = 0; j < cols; ++j) {
+      result = std::max(result, std::abs(row[j]));
+    }
+  }
+  return result;
+}
+
+// Whether a pivot of elimination on an n x n matrix whose largest element
+// has magnitude norm is too small to tell from rounding error. This, not
+// the determinant, decides whether a floating-point matrix is singular:
+// scaling the matrix scales both sides, while the determinant of a
+// well-conditioned matrix can underflow.
+template <typename T>
+bool S21NegligiblePivot(T pivot, T norm, int n) noexcept {
+  return !(std::abs(pivot) > n * std::numeric_limits<T>::epsilon() * norm);
+}
+
+// Whether any diagonal element of the n x n triangular factor at r, rows
+// ldr apart, is a negligible pivot.
+template <typename T>
+bool S21HasNegligiblePivot(int n, const T* r, int ldr, T norm) noexcept {
+  bool negligible = false;
+  for (int i = 0; i < n && !negligible; ++i) {
+    negligible =
+        S21NegligiblePivot(r[static_cast<std::ptrdiff_t>(i) * ldr + i], norm,
+                           n);
+  }
+  return negligible;
+}
+
+// Arithmetic Solve() factors in. kFull uses the matrix's own element type.
+// kMixed factors a double matrix in float, about twice as fast, and refines
+// the solution in double to the same accuracy, falling back to kFull when
+// refinement stalls; other element types ignore it. Each refinement step
+// multiplies A by the solution, so kMixed only pays off for large matrices
+// and few right-hand sides.
+enum class S21Precision { kFull, kMixed };
+
+// What the caller knows about a square matrix. kPositiveDefinite promises a
+// symmetric positive-definite one, which Determinant(), InverseMatrix() and
+// Solve() then factor by Cholesky in half the work of LU, reading only the
+// lower triangle; they throw if the promise does not hold. Integer matrices
+// ignore it.
+enum class S21Structure { kGeneral, kPositiveDefinite };
+
+template <typename T>
+S21BasicMatrix<T> operator*(const S21BasicMatrixView<const T>& lhs,
+                            const S21BasicMatrixView<const T>& rhs);
+
+// Dense matrix of double, float or std::int64_t elements; S21Matrix is the
+// double one. Float halves the memory traffic and doubles the lanes of every
+// vector kernel at the cost of precision. Integer matrices are exact:
+// their determinant and cofactors come from fraction-free elimination,
+// whose intermediate values are minors of the matrix and must fit in
+// std::int64_t, and only matrices with determinant 1 or -1 have an inverse.
+template <typename T>
+class S21BasicMatrix {
+  static_assert(std::is_same<T, double>::value ||
+                    std::is_same<T, float>::value ||
+                    std::is_same<T, std::int64_t>::value,
+                "elements are double, float or std::int64_t");
+
+  using ConstView = S21BasicMatrixView<const T>;
 
-class S21Matrix {
  public:
-  S21Matrix() noexcept = default;
-  explicit S21Matrix(const int rows, const int cols) noexcept;
-  S21Matrix(const S21Matrix& other) noexcept;
-  S21Matrix(S21Matrix&& other) noexcept;
-  ~S21Matrix() noexcept;
-
-  bool EqMatrix(const S21Matrix& other) const noexcept;
-  void SumMatrix(const S21Matrix& other);
-  void SubMatrix(const S21Matrix& other);
-  void MulNumber(const double num);
-  void MulMatrix(const S21Matrix& other);
-  S21Matrix Transpose();
-  S21Matrix CalcComplements();
-  double Determinant() const;
-  S21Matrix InverseMatrix();
-
-  S21Matrix operator+(const S21Matrix& other);
-  S21Matrix operator-(const S21Matrix& other);
-  S21Matrix operator*(const S21Matrix& other);
-  S21Matrix operator*(const double other);
-  friend S21Matrix operator*(const double other, S21Matrix& tmp);
-  bool operator==(const S21Matrix& other);
-  S21Matrix& operator=(S21Matrix&& other);
-  S21Matrix& operator=(const S21Matrix& other);
-  S21Matrix& operator+=(const S21Matrix& other);
-  S21Matrix& operator-=(const S21Matrix& other);
-  S21Matrix& operator*=(const S21Matrix& other);
-  S21Matrix& operator*=(const double other);
-  double& operator()(int i, int j);
-  double operator()(int i, int j) const;
+  using Scalar = T;
+
+  S21BasicMatrix() noexcept = default;
+  explicit S21BasicMatrix(const int rows, const int cols) noexcept;
+  // Takes heap storage from allocator instead of the process-wide one; see
+  // S21SetMatrixAllocator(). Copies share the allocator.
+  explicit S21BasicMatrix(const int rows, const int cols,
+                          S21MatrixAllocator& allocator) noexcept;
+  // Copies of a heap-backed matrix share its buffer until either side is
+  // written, so copying is O(1); see Detach(). A matrix that has handed out
+  // a writable reference or view copies eagerly from then on.
+  S21BasicMatrix(const S21BasicMatrix& other) noexcept;
+  S21BasicMatrix(S21BasicMatrix&& other) noexcept;
+  // Converts the elements of a matrix of another type; conversions to
+  // integers round toward zero.
+  template <typename U,
+            typename = std::enable_if_t<!std::is_same<U, T>::value>>
+  explicit S21BasicMatrix(const S21BasicMatrix<U>& other) noexcept;
+  // Evaluates an elementwise expression such as a + b * 2.0 - c in one pass.
+  template <typename E, typename = S21EnableIfExprOf<E, T>>
+  S21BasicMatrix(const S21MatrixExpr<E>& expr);
+  // Copies the elements of a view out into a new matrix, so a read-only
+  // view such as Transpose() can stand in wherever a matrix is expected.
+  S21BasicMatrix(const ConstView& view) noexcept;
+  ~S21BasicMatrix() noexcept;
+
+  bool EqMatrix(const S21BasicMatrix& other) const noexcept;
+  bool EqMatrix(const ConstView& other) const noexcept;
+  void SumMatrix(const S21BasicMatrix& other);
+  void SumMatrix(const ConstView& other);
+  void SubMatrix(const S21BasicMatrix& other);
+  void SubMatrix(const ConstView& other);
+  void MulNumber(const T num);
+  void MulMatrix(const S21BasicMatrix& other);
+  void MulMatrix(const ConstView& other);
+  // Transposed view of this matrix; nothing is copied until the view is
+  // assigned to a matrix. Temporaries are transposed into a new matrix.
+  ConstView Transpose() const&;
+  S21BasicMatrix Transpose() &&;
+  // Transposes the matrix within its own buffer. Square matrices swap
+  // blocks pairwise; rectangular ones follow the cycles of the permutation,
+  // which is slower than copying out a.Transpose() but needs no second
+  // buffer.
+  void TransposeInPlace();
+  S21BasicMatrix CalcComplements();
+  T Determinant(S21Structure structure = S21Structure::kGeneral) const;
+  S21BasicMatrix InverseMatrix(
+      S21Structure structure = S21Structure::kGeneral);
+  // Solution x of this * x = b, one column per column of b, found by
+  // factoring this matrix instead of inverting it, which takes a third of
+  // the work of InverseMatrix() * b and is more accurate. Throws like
+  // InverseMatrix() for a singular matrix. Integer solutions are exact and
+  // must have integer elements.
+  S21BasicMatrix Solve(const ConstView& b,
+                       S21Precision precision = S21Precision::kFull) const;
+  S21BasicMatrix Solve(const ConstView& b, S21Structure structure) const;
+  // Solution x minimizing the norm of this * x - b, one column per column
+  // of b. The matrix needs at least as many rows as columns, and linearly
+  // independent columns; otherwise this throws. Floating-point matrices
+  // are factored by blocked Householder QR, which suits tall ones with
+  // millions of rows. Integer ones solve the normal equations exactly and
+  // the solution must have integer elements.
+  S21BasicMatrix LeastSquares(const ConstView& b) const;
+
+  bool operator==(const S21BasicMatrix& other) const;
+  S21BasicMatrix& operator=(S21BasicMatrix&& other);
+  S21BasicMatrix& operator=(const S21BasicMatrix& other);
+  template <typename E>
+  S21BasicMatrix& operator=(const S21MatrixExpr<E>& expr);
+  S21BasicMatrix& operator+=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator-=(const S21BasicMatrix& other);
+  template <typename E>
+  S21BasicMatrix& operator+=(const S21MatrixExpr<E>& expr);
+  template <typename E>
+  S21BasicMatrix& operator-=(const S21MatrixExpr<E>& expr);
+  S21BasicMatrix& operator*=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator*=(const T other);
+  T& operator()(int i, int j);
+  T operator()(int i, int j) const;
 
+  // Resizing keeps the elements that remain and zeroes new ones. Shrinking
+  // keeps the buffer, and growing reuses spare capacity; new rows beyond it
+  // are allocated geometrically, so repeated growth is amortized O(cols).
   void MutateRows(int rows) noexcept;
   void MutateCols(int cols) noexcept;
   int AccessRows() const noexcept;
   int AccessCols() const noexcept;
+  // Makes room for at least rows x cols elements so that growing up to that
+  // shape does not reallocate. Never shrinks the buffer.
+  void Reserve(int rows, int cols);
+  // Moves the elements to a buffer of exactly their size.
+  void ShrinkToFit() noexcept;
+  // Appends one row of AccessCols() values, or rows such rows stored one
+  // after another. The values may be elements of this matrix.
+  void AppendRow(const T* values);
+  void AppendRows(const T* values, int rows);
 
  private:
+  friend class S21LU;
+  friend class S21Cholesky;
+  friend class S21QR;
+  friend class S21Eigen;
+  template <typename>
+  friend class S21BasicMatrix;
+  template <typename>
+  friend class S21MatrixTerm;
+  template <typename>
+  friend class S21BasicMatrixView;
+  friend S21BasicMatrix operator*<T>(const ConstView& lhs,
+                                     const ConstView& rhs);
+
+  // Elements live in one row-major buffer of capacity_ elements aligned to
+  // kAlignment bytes; element (i, j) is matrix_[i * stride_ + j], so
+  // stride_ bounds the columns and capacity_ / stride_ the rows that fit
+  // without reallocating. Buffers of up to kSmallSize elements use the
+  // inline small_ array instead of the heap.
+  // Heap buffers come from allocator_, which is fixed at the first heap
+  // allocation unless the constructor was given one, and moves with the
+  // buffer. A heap buffer copied from another matrix is shared with it
+  // through shared_, an owner count created by the first copy. Once a
+  // writable reference or view into the buffer exists, writes through it
+  // bypass Detach(), so pinned_ keeps the buffer from being shared until
+  // it is released.
+  static constexpr std::size_t kAlignment = 64;
+  static constexpr int kSmallSize = 16;
+
+  struct SharedBuffer {
+    std::atomic<int> owners;
+  };
+
   int rows_{0}, cols_{0};
-  double** matrix_ = nullptr;
+  int stride_{0};
+  std::size_t capacity_{0};
+  T* matrix_ = nullptr;
+  S21MatrixAllocator* allocator_ = nullptr;
+  mutable std::atomic<SharedBuffer*> shared_{nullptr};
+  bool pinned_{false};
+  alignas(16) T small_[kSmallSize];
+
+  T* Row(int i) noexcept {
+    return matrix_ + static_cast<std::ptrdiff_t>(i) * stride_;
+  }
+  const T* Row(int i) const noexcept {
+    return matrix_ + static_cast<std::ptrdiff_t>(i) * stride_;
+  }
+  T& At(int i, int j) noexcept { return Row(i)[j]; }
+  T At(int i, int j) const noexcept { return Row(i)[j]; }
+  bool IsContiguous() const noexcept { return stride_ == cols_; }
+  bool IsSmall() const noexcept { return matrix_ == small_; }
+  bool IsShared() const noexcept {
+    return shared_.load(std::memory_order_relaxed) != nullptr;
+  }
+  long Size() const noexcept { return static_cast<long>(rows_) * cols_; }
+  bool IsEmpty() const noexcept { return rows_ <= 0 || cols_ <= 0; }
+  int RowCapacity() const noexcept {
+    return stride_ ? static_cast<int>(capacity_ / stride_) : 0;
+  }
+  // Length of the heap buffer in the doubles that allocators hand out.
+  std::size_t BufferDoubles() const noexcept {
+    return (capacity_ * sizeof(T) + sizeof(double) - 1) / sizeof(double);
+  }
 
   void CreateMatrix() noexcept;
+  void AllocateBuffer(int rows, int stride) noexcept;
+  S21BasicMatrix Reallocate(int rows, int stride) noexcept;
   void DeleteMatrix() noexcept;
+  void StealMatrix(S21BasicMatrix& other) noexcept;
+  void ShareMatrix(const S21BasicMatrix& other) noexcept;
+  void Detach() noexcept;
+  void Pin() noexcept;
+  bool IsShareable() const noexcept {
+    return !IsSmall() && matrix_ && !pinned_;
+  }
   void CopyMatrix(const int rows, const int cols,
-                  const S21Matrix& other) noexcept;
-  void Minor(S21Matrix* A, int colums, int rows) const noexcept;
-  double DeterminantMinor(int row, int colum) noexcept;
-  void SumSubMatrix(const int tmp, const S21Matrix& other) noexcept;
-  S21Matrix CalcCompHelper() noexcept;
-  double DetermHelper() const noexcept;
+                  const S21BasicMatrix& other) noexcept;
+  void SumSubMatrix(const int tmp, const ConstView& other) noexcept;
+  static S21BasicMatrix CalcCompHelper(const ConstView& source);
+  static T DetermHelper(const ConstView& source);
+  static T DetermOf(const ConstView& source, S21Structure structure);
+  static const T* GemmOperand(const ConstView& view, S21ArenaScope* scratch,
+                              int* ld, bool* trans);
+  static S21BasicMatrix InverseOf(const ConstView& source,
+                                  S21Structure structure);
+  static S21BasicMatrix SolveOf(const ConstView& a, const ConstView& b,
+                                S21Precision precision,
+                                S21Structure structure);
+  static S21BasicMatrix LeastSquaresOf(const ConstView& a,
+                                       const ConstView& b);
+  bool InverseHelper();
+  bool SmallInverseHelper() noexcept;
+  int CompletePivotLU(int* row_perm, int* col_perm);
+  template <typename E>
+  void EvaluateExpr(const E& expr) noexcept;
 };
 
+template <typename T>
+template <typename U, typename>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix<U>& other) noexcept
+    : S21BasicMatrix(other.rows_, other.cols_) {
+  for (int i = 0; i < rows_ && cols_ > 0; ++i) {
+    const U* row = other.Row(i);
+    T* out = Row(i);
+    for (int j = 0; j < cols_; ++j) {
+      out[j] = static_cast<T>(row[j]);
+    }
+  }
+}
+
+// Overloads for temporary operands update the temporary's buffer in place and
+// hand it on as the result instead of allocating a new one.
+template <typename T>
+S21BasicMatrix<T> operator+(S21BasicMatrix<T>&& lhs,
+                            const S21BasicMatrix<T>& rhs) {
+  lhs += rhs;
+  return std::move(lhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator+(const S21BasicMatrix<T>& lhs,
+                            S21BasicMatrix<T>&& rhs) {
+  rhs += lhs;
+  return std::move(rhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator+(S21BasicMatrix<T>&& lhs, S21BasicMatrix<T>&& rhs) {
+  lhs += rhs;
+  return std::move(lhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator-(S21BasicMatrix<T>&& lhs,
+                            const S21BasicMatrix<T>& rhs) {
+  lhs -= rhs;
+  return std::move(lhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator-(const S21BasicMatrix<T>& lhs,
+                            S21BasicMatrix<T>&& rhs) {
+  rhs = lhs - rhs;
+  return std::move(rhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator-(S21BasicMatrix<T>&& lhs, S21BasicMatrix<T>&& rhs) {
+  lhs -= rhs;
+  return std::move(lhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(S21BasicMatrix<T>&& lhs,
+                            const typename S21BasicMatrix<T>::Scalar rhs) {
+  lhs *= rhs;
+  return std::move(lhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(const typename S21BasicMatrix<T>::Scalar lhs,
+                            S21BasicMatrix<T>&& rhs) {
+  rhs *= lhs;
+  return std::move(rhs);
+}
+
+#include "s21_matrix_expr.h"
+#include "s21_matrix_view.h"
+
 #endif  // CPP_S21_MATRIXPLUS_SRC_S21_MATRIX_OOP_H_
\ No newline at end of file
@@ -0,0 +1,355 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "s21_eigen.h"
+#include "s21_matrix_oop.h"
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Runs fn repeatedly for at least min_seconds and returns seconds per call.
+template <typename Fn>
+double TimeIt(Fn fn, double min_seconds = 0.2) {
+  int calls = 0;
+  double elapsed = 0;
+  const auto start = Clock::now();
+  while (elapsed < min_seconds || calls == 0) {
+    fn();
+    ++calls;
+    elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+  }
+  return elapsed / calls;
+}
+
+S21Matrix RandomMatrix(int rows, int cols) {
+  S21Matrix result(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      result(i, j) = std::rand() / static_cast<double>(RAND_MAX) - 0.5;
+    }
+  }
+  return result;
+}
+
+// The i-j-k triple loop MulMatrix() used before the blocked kernel.
+void NaiveMultiply(int n, const std::vector<double>& a,
+                   const std::vector<double>& b, std::vector<double>* c) {
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      double sum = 0;
+      for (int k = 0; k < n; ++k) {
+        sum += a[i * n + k] * b[k * n + j];
+      }
+      (*c)[i * n + j] = sum;
+    }
+  }
+}
+
+void BenchMulMatrix(int max_size, int max_naive_size) {
+  std::printf("%-8s %14s %14s\n", "n", "naive GFLOP/s", "gemm GFLOP/s");
+  for (int n = 64; n <= max_size; n *= 2) {
+    const double flops = 2.0 * n * n * n;
+    const S21Matrix a = RandomMatrix(n, n);
+    const S21Matrix b = RandomMatrix(n, n);
+
+    double naive = 0;
+    if (n <= max_naive_size) {
+      std::vector<double> raw_a(n * n), raw_b(n * n), raw_c(n * n);
+      for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+          raw_a[i * n + j] = a(i, j);
+          raw_b[i * n + j] = b(i, j);
+        }
+      }
+      naive = flops / TimeIt([&] { NaiveMultiply(n, raw_a, raw_b, &raw_c); });
+    }
+    const double gemm = flops / TimeIt([&] {
+                          S21Matrix c(a);
+                          c.MulMatrix(b);
+                        });
+
+    if (n <= max_naive_size) {
+      std::printf("%-8d %14.2f %14.2f\n", n, naive * 1e-9, gemm * 1e-9);
+    } else {
+      std::printf("%-8d %14s %14.2f\n", n, "-", gemm * 1e-9);
+    }
+  }
+}
+
+// GFLOP/s of MulMatrix() and LU Determinant() at size n for 1 to 64 threads.
+void BenchThreads(int n) {
+  const int threads = S21ThreadCount();
+  const S21Matrix a = RandomMatrix(n, n);
+  const S21Matrix b = RandomMatrix(n, n);
+  std::printf("%-8s %14s %9s %14s %9s\n", "threads", "gemm GFLOP/s",
+              "speedup", "lu GFLOP/s", "speedup");
+  double gemm_base = 0;
+  double lu_base = 0;
+  for (int t = 1; t <= 64; t *= 2) {
+    S21SetThreadCount(t);
+    const double gemm = 2.0 * n * n * n / TimeIt([&] {
+                          S21Matrix c(a);
+                          c.MulMatrix(b);
+                        });
+    const double lu =
+        2.0 / 3.0 * n * n * n / TimeIt([&] { a.Determinant(); });
+    if (t == 1) {
+      gemm_base = gemm;
+      lu_base = lu;
+    }
+    std::printf("%-8d %14.2f %9.2f %14.2f %9.2f\n", t, gemm * 1e-9,
+                gemm / gemm_base, lu * 1e-9, lu / lu_base);
+  }
+  S21SetThreadCount(threads);
+}
+
+// Nanoseconds per construct, copy, move and destroy of small n x n matrices.
+void BenchLifetime() {
+  std::printf("%-8s %12s %12s %12s\n", "n", "create ns", "copy ns",
+              "move ns");
+  for (int n = 2; n <= 8; ++n) {
+    const S21Matrix a = RandomMatrix(n, n);
+    volatile double sink = 0;
+    const double create = TimeIt([&] {
+      S21Matrix b(n, n);
+      sink = b(0, 0);
+    });
+    const double copy = TimeIt([&] {
+      S21Matrix b(a);
+      sink = b(0, 0);
+    });
+    const double move = TimeIt([&] {
+      S21Matrix b(a);
+      S21Matrix c(std::move(b));
+      S21Matrix d;
+      d = std::move(c);
+      sink = d(0, 0);
+    });
+    std::printf("%-8d %12.1f %12.1f %12.1f\n", n, create * 1e9, copy * 1e9,
+                (move - copy) * 1e9);
+  }
+
+  // Copies share the buffer until written; the first write pays the copy.
+  const S21Matrix big(3620, 3620);
+  const double share = TimeIt([&] { S21Matrix b(big); });
+  const double write = TimeIt([&] {
+    S21Matrix b(big);
+    b(0, 0) = 1;
+  });
+  std::printf("copy of 100 MB: %.1f ns, then first write: %.1f ms\n",
+              share * 1e9, write * 1e3);
+
+  // Row-at-a-time ingest reallocates only when the capacity doubles.
+  const double row[16] = {};
+  const double append = TimeIt([&] {
+    S21Matrix samples(0, 16);
+    for (int i = 0; i < 100000; ++i) {
+      samples.AppendRow(row);
+    }
+  });
+  std::printf("append 100000 rows of 16: %.1f ns per row\n",
+              append / 100000 * 1e9);
+}
+
+// The column-strided store loop Transpose() used before blocking.
+void NaiveTranspose(int rows, int cols, const std::vector<double>& a,
+                    std::vector<double>* b) {
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      (*b)[j * rows + i] = a[i * cols + j];
+    }
+  }
+}
+
+// Milliseconds per transpose of an n x n and an n x n/2 matrix: the naive
+// loop, the blocked copy into a preallocated matrix, and in place.
+void BenchTranspose(int n) {
+  std::printf("%-12s %10s %10s %10s\n", "shape", "naive ms", "blocked ms",
+              "inplace ms");
+  for (int cols : {n, n / 2}) {
+    const S21Matrix a = RandomMatrix(n, cols);
+    std::vector<double> raw_a(static_cast<std::size_t>(n) * cols);
+    std::vector<double> raw_b(raw_a.size());
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < cols; ++j) {
+        raw_a[static_cast<std::size_t>(i) * cols + j] = a(i, j);
+      }
+    }
+    const double naive =
+        TimeIt([&] { NaiveTranspose(n, cols, raw_a, &raw_b); });
+    S21Matrix b(cols, n);
+    const double blocked = TimeIt([&] { b = a.Transpose(); });
+    S21Matrix c(a);
+    const double inplace = TimeIt([&] { c.TransposeInPlace(); });
+    char shape[32];
+    std::snprintf(shape, sizeof(shape), "%dx%d", n, cols);
+    std::printf("%-12s %10.2f %10.2f %10.2f\n", shape, naive * 1e3,
+                blocked * 1e3, inplace * 1e3);
+  }
+}
+
+// GFLOP/s of double and float products, and the largest difference
+// between them.
+void BenchPrecision(int max_size) {
+  std::printf("%-8s %14s %14s %12s\n", "n", "double GFLOP/s", "float GFLOP/s",
+              "max error");
+  for (int n = 256; n <= max_size; n *= 2) {
+    const double flops = 2.0 * n * n * n;
+    const S21Matrix a = RandomMatrix(n, n);
+    const S21Matrix b = RandomMatrix(n, n);
+    const S21FloatMatrix fa(a);
+    const S21FloatMatrix fb(b);
+    S21Matrix c;
+    S21FloatMatrix fc;
+    const double seconds = TimeIt([&] { c = a * b; });
+    const double fseconds = TimeIt([&] { fc = fa * fb; });
+    const S21Matrix widened(fc);
+    double error = 0;
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        error = std::max(error, std::fabs(widened(i, j) - c(i, j)));
+      }
+    }
+    std::printf("%-8d %14.2f %14.2f %12.2e\n", n, flops / seconds * 1e-9,
+                flops / fseconds * 1e-9, error);
+  }
+}
+
+// Milliseconds to solve A * X = B with one and with n right-hand sides:
+// inverting A and multiplying, Solve(), and Solve() in mixed precision.
+void BenchSolve(int max_size) {
+  std::printf("%-8s %6s %12s %12s %12s\n", "n", "rhs", "inverse ms",
+              "solve ms", "mixed ms");
+  for (int n = 256; n <= max_size; n *= 2) {
+    S21Matrix a = RandomMatrix(n, n);
+    for (int i = 0; i < n; ++i) {
+      a(i, i) += 2;
+    }
+    for (int rhs : {1, n}) {
+      const S21Matrix b = RandomMatrix(n, rhs);
+      S21Matrix x;
+      const double inverse =
+          TimeIt([&] { x = S21Matrix(a).InverseMatrix() * b; });
+      const double solve = TimeIt([&] { x = a.Solve(b); });
+      const double mixed =
+          TimeIt([&] { x = a.Solve(b, S21Precision::kMixed); });
+      std::printf("%-8d %6d %12.2f %12.2f %12.2f\n", n, rhs, inverse * 1e3,
+                  solve * 1e3, mixed * 1e3);
+    }
+  }
+}
+
+// Milliseconds to solve a positive-definite A * x = b by LU and by
+// Cholesky, and the rate of the Cholesky factorization alone.
+void BenchCholesky(int max_size) {
+  std::printf("%-8s %12s %12s %18s\n", "n", "lu ms", "cholesky ms",
+              "cholesky GFLOP/s");
+  const S21Structure spd = S21Structure::kPositiveDefinite;
+  for (int n = 256; n <= max_size; n *= 2) {
+    const S21Matrix m = RandomMatrix(n, n);
+    S21Matrix a = m.Transpose() * m;
+    for (int i = 0; i < n; ++i) {
+      a(i, i) += n;
+    }
+    const S21Matrix b = RandomMatrix(n, 1);
+    S21Matrix x;
+    const double lu = TimeIt([&] { x = a.Solve(b); });
+    const double cholesky = TimeIt([&] { x = a.Solve(b, spd); });
+    const double factor = TimeIt([&] { a.Determinant(spd); });
+    std::printf("%-8d %12.2f %12.2f %18.2f\n", n, lu * 1e3, cholesky * 1e3,
+                n / 3.0 * n * n / factor * 1e-9);
+  }
+}
+
+// Milliseconds to fit 32 columns to rows observations by LeastSquares()
+// and by the normal equations, which square the condition number, and the
+// rate of the QR fit in 2 * rows * 32^2 flops.
+void BenchLeastSquares(int max_rows) {
+  const int n = 32;
+  std::printf("%-10s %12s %12s %10s\n", "rows", "qr ms", "normal ms",
+              "qr GFLOP/s");
+  const S21Structure spd = S21Structure::kPositiveDefinite;
+  for (int m = 1 << 14; m <= max_rows; m *= 4) {
+    const S21Matrix a = RandomMatrix(m, n);
+    const S21Matrix b = RandomMatrix(m, 1);
+    S21Matrix x;
+    const double qr = TimeIt([&] { x = a.LeastSquares(b); });
+    const double normal = TimeIt(
+        [&] { x = (a.Transpose() * a).Solve(a.Transpose() * b, spd); });
+    std::printf("%-10d %12.2f %12.2f %10.2f\n", m, qr * 1e3, normal * 1e3,
+                2.0 * m * n * n / qr * 1e-9);
+  }
+}
+
+// Milliseconds to find the eigenvalues of a symmetric matrix, and its
+// eigenvectors too, with the largest residual |A * v - w * v| of the
+// latter.
+void BenchEigen(int max_size) {
+  std::printf("%-8s %12s %12s %12s\n", "n", "values ms", "vectors ms",
+              "residual");
+  for (int n = 500; n <= max_size; n *= 2) {
+    const S21Matrix m = RandomMatrix(n, n);
+    const S21Matrix a = m + m.Transpose();
+    const double values = TimeIt([&] { S21Eigen(a, false); });
+    const double vectors = TimeIt([&] { S21Eigen(a, true); });
+    const S21Eigen eigen(a);
+    const S21Matrix av = a * eigen.Vectors();
+    double residual = 0;
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        residual = std::max(
+            residual,
+            std::abs(av(i, j) - eigen.Vectors()(i, j) * eigen.Values()[j]));
+      }
+    }
+    std::printf("%-8d %12.2f %12.2f %12.2e\n", n, values * 1e3,
+                vectors * 1e3, residual);
+  }
+}
+
+}  // namespace
+
+// Usage: ./bench.out [max_size [max_naive_size]]
+//        ./bench.out threads [size]
+//        ./bench.out small
+//        ./bench.out transpose [size]
+//        ./bench.out precision [max_size]
+//        ./bench.out solve [max_size]
+//        ./bench.out cholesky [max_size]
+//        ./bench.out lstsq [max_rows]
+//        ./bench.out eigen [max_size]
+// Set S21_MATRIX_ISA to compare instruction sets.
+int main(int argc, char** argv) {
+  std::printf("isa: %s, threads: %d\n", S21IsaName(S21ActiveIsa()),
+              S21ThreadCount());
+  if (argc > 1 && std::strcmp(argv[1], "threads") == 0) {
+    BenchThreads(argc > 2 ? std::atoi(argv[2]) : 2048);
+  } else if (argc > 1 && std::strcmp(argv[1], "small") == 0) {
+    BenchLifetime();
+  } else if (argc > 1 && std::strcmp(argv[1], "transpose") == 0) {
+    BenchTranspose(argc > 2 ? std::atoi(argv[2]) : 4096);
+  } else if (argc > 1 && std::strcmp(argv[1], "precision") == 0) {
+    BenchPrecision(argc > 2 ? std::atoi(argv[2]) : 2048);
+  } else if (argc > 1 && std::strcmp(argv[1], "solve") == 0) {
+    BenchSolve(argc > 2 ? std::atoi(argv[2]) : 2048);
+  } else if (argc > 1 && std::strcmp(argv[1], "cholesky") == 0) {
+    BenchCholesky(argc > 2 ? std::atoi(argv[2]) : 2048);
+  } else if (argc > 1 && std::strcmp(argv[1], "lstsq") == 0) {
+    BenchLeastSquares(argc > 2 ? std::atoi(argv[2]) : 1 << 20);
+  } else if (argc > 1 && std::strcmp(argv[1], "eigen") == 0) {
+    BenchEigen(argc > 2 ? std::atoi(argv[2]) : 2000);
+  } else {
+    BenchMulMatrix(argc > 1 ? std::atoi(argv[1]) : 4096,
+                   argc > 2 ? std::atoi(argv[2]) : 1024);
+  }
+  return 0;
+}
@@ -1,6 +1,48 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "s21_allocator.h"
+#include "s21_arena.h"
+#include "s21_cholesky.h"
+#include "s21_eigen.h"
+#include "s21_fixed_matrix.h"
+#include "s21_gemm.h"
+#include "s21_lu.h"
 #include "s21_matrix_oop.h"
+#include "s21_qr.h"
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Matrix buffers are the only over-aligned allocations, so counting them
+// counts matrix allocations.
+std::atomic<long> aligned_allocations{0};
+
+}  // namespace
+
+void* operator new(std::size_t size, std::align_val_t align) {
+  const std::size_t alignment = static_cast<std::size_t>(align);
+  void* ptr = std::aligned_alloc(
+      alignment, (size + alignment - 1) / alignment * alignment);
+  if (!ptr) {
+    throw std::bad_alloc();
+  }
+  ++aligned_allocations;
+  return ptr;
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
 
 TEST(Constructor, test_1) {
   S21Matrix a;
@@ -497,6 +539,34 @@ TEST(MulMatrix, test_19) {
   }
 }
 
+TEST(MulMatrix, blockedSizes) {
+  const int sizes[][3] = {{131, 300, 45}, {7, 513, 260}, {200, 9, 97}};
+  for (const auto& size : sizes) {
+    S21Matrix a(size[0], size[1]);
+    S21Matrix b(size[1], size[2]);
+    for (int i = 0; i < a.AccessRows(); i++) {
+      for (int j = 0; j < a.AccessCols(); j++) {
+        a(i, j) = ((i * 3 + j * 7) % 13) / 13.0 - 0.5;
+      }
+    }
+    for (int i = 0; i < b.AccessRows(); i++) {
+      for (int j = 0; j < b.AccessCols(); j++) {
+        b(i, j) = ((i * 5 + j * 2) % 11) / 11.0 - 0.5;
+      }
+    }
+    S21Matrix expected(size[0], size[2]);
+    for (int i = 0; i < size[0]; i++) {
+      for (int j = 0; j < size[2]; j++) {
+        for (int k = 0; k < size[1]; k++) {
+          expected(i, j) += a(i, k) * b(k, j);
+        }
+      }
+    }
+    a.MulMatrix(b);
+    EXPECT_TRUE(a == expected);
+  }
+}
+
 TEST(Transpose, test_20) {
   S21Matrix a(3, 2);
   S21Matrix b(2, 3);
@@ -623,6 +693,45 @@ TEST(Transpose, test_24) {
   EXPECT_DOUBLE_EQ(a.CalcComplements()(0, 0), 1);
 }
 
+TEST(Transpose, calcComplementsSingular) {
+  double values[] = {2, -1, 3, 0, 1, 4, -2, 5, 3, 3, 1, 5, 0, 2, 7, -1};
+  double expected[] = {-75, -63, 29,  77,  -75, -63, 29, 77,
+                       75,  63,  -29, -77, 0,   0,   0,  0};
+  S21Matrix a(4, 4);
+  S21Matrix result(4, 4);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      a(i, j) = values[i * 4 + j];
+      result(i, j) = expected[i * 4 + j];
+    }
+  }
+  EXPECT_TRUE(a.CalcComplements().EqMatrix(result));
+
+  for (int j = 0; j < 4; j++) {
+    a(1, j) = 2 * a(0, j);
+    a(3, j) = 3 * a(0, j);
+  }
+  EXPECT_TRUE(a.CalcComplements().EqMatrix(S21Matrix(4, 4)));
+}
+
+TEST(Transpose, calcComplementsLarge) {
+  S21Matrix a(30, 30);
+  for (int i = 0; i < a.AccessRows(); i++) {
+    for (int j = 0; j < a.AccessCols(); j++) {
+      a(i, j) = ((i * 5 + j * 3) % 7) / 7.0;
+    }
+    a(i, i) += 1.0;
+  }
+  S21Matrix complements = a.CalcComplements();
+  S21Matrix product = a * complements.Transpose();
+  double det = a.Determinant();
+  for (int i = 0; i < a.AccessRows(); i++) {
+    for (int j = 0; j < a.AccessCols(); j++) {
+      EXPECT_NEAR(product(i, j), i == j ? det : 0.0, 1e-7 * std::abs(det));
+    }
+  }
+}
+
 TEST(Transpose, test_25) {
   S21Matrix a(5, 5);
   S21Matrix b(0, 5);
@@ -698,7 +807,7 @@ TEST(Transpose, test_25) {
   res2 = a.Determinant();
 
   EXPECT_EQ(b.EqMatrix(result), true);
-  EXPECT_EQ(res1, res2);
+  EXPECT_NEAR(res1, res2, 1e-7);
 }
 
 TEST(Determinant, test_26) {
@@ -709,6 +818,43 @@ TEST(Determinant, test_26) {
   EXPECT_DOUBLE_EQ(a.Determinant(), 1.0);
 }
 
+TEST(Determinant, largeMatrix) {
+  S21Matrix a(12, 12);
+  for (int i = 0; i < a.AccessRows(); i++) {
+    for (int j = 0; j < a.AccessCols(); j++) {
+      a(i, j) = (i == j) ? 2.0 : 1.0;
+    }
+  }
+  EXPECT_NEAR(a.Determinant(), 13.0, 1e-7);
+}
+
+TEST(Determinant, needsPivoting) {
+  S21Matrix a(4, 4);
+  a(0, 1) = 1.0;
+  a(1, 0) = 1.0;
+  a(2, 3) = 2.0;
+  a(3, 2) = 3.0;
+  EXPECT_NEAR(a.Determinant(), 6.0, 1e-7);
+
+  a(3, 2) = 0.0;
+  EXPECT_DOUBLE_EQ(a.Determinant(), 0.0);
+}
+
+TEST(Determinant, luMatchesCofactor) {
+  S21Matrix a(4, 4);
+  double values[] = {3, -2, 5, 1, 7, 0.5, -4, 2, 1, 6, 2, -3, 4, 4, 1, 8};
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      a(i, j) = values[i * 4 + j];
+    }
+  }
+  S21LU lu(a);
+  EXPECT_FALSE(lu.IsSingular());
+  EXPECT_NEAR(lu.Determinant(), 2915.0, 1e-7);
+  EXPECT_NEAR(a.Determinant(), 2915.0, 1e-7);
+  EXPECT_THROW(S21LU(S21Matrix(2, 3)), std::length_error);
+}
+
 TEST(operator, test_26) {
   S21Matrix a(1, 2);
   EXPECT_THROW(a.Determinant(), std::length_error);
@@ -779,6 +925,65 @@ TEST(InverseMatrix, test_29) {
   EXPECT_THROW(b.InverseMatrix(), std::length_error);
 }
 
+TEST(InverseMatrix, largeMatrix) {
+  S21Matrix a(8, 8);
+  S21Matrix identity(8, 8);
+  for (int i = 0; i < a.AccessRows(); i++) {
+    for (int j = 0; j < a.AccessCols(); j++) {
+      a(i, j) = ((i * 7 + j * 3) % 11) - 5.0;
+    }
+    a(i, i) += 20.0;
+    identity(i, i) = 1.0;
+  }
+  a(0, 0) = 0.0;
+
+  S21Matrix inverse = a.InverseMatrix();
+  S21Matrix product = a * inverse;
+
+  EXPECT_TRUE(product == identity);
+}
+
+TEST(InverseMatrix, largeSingular) {
+  S21Matrix a(5, 5);
+  for (int i = 0; i < a.AccessRows(); i++) {
+    for (int j = 0; j < a.AccessCols(); j++) {
+      a(i, j) = i + j;
+    }
+  }
+  EXPECT_THROW(a.InverseMatrix(), std::length_error);
+  EXPECT_THROW(S21Matrix(4, 5).InverseMatrix(), std::length_error);
+}
+
+TEST(InverseMatrix, singularityIgnoresScale) {
+  // det(0.5 * I) = 2^-30 is tiny, but the matrix is perfectly conditioned.
+  const S21Structure spd = S21Structure::kPositiveDefinite;
+  S21Matrix half(30, 30), identity(30, 30);
+  for (int i = 0; i < 30; i++) {
+    half(i, i) = 0.5;
+    identity(i, i) = 1;
+  }
+  EXPECT_TRUE(half * half.InverseMatrix() == identity);
+  EXPECT_TRUE(half * half.InverseMatrix(spd) == identity);
+  EXPECT_TRUE(half.Solve(identity) == identity * 2.0);
+  EXPECT_TRUE(half.Solve(identity, spd) == identity * 2.0);
+  EXPECT_TRUE(half.Solve(identity, S21Precision::kMixed) == identity * 2.0);
+  S21Matrix small(2, 2);
+  small(0, 0) = small(1, 1) = 1e-4;
+  EXPECT_EQ(small.InverseMatrix()(1, 1), 1e4);
+
+  // det = 1e6 is large, but 1e-6 is lost against 1e12 in rounding.
+  S21Matrix stiff(2, 2), stiff_large(4, 4);
+  stiff(0, 0) = 1e12;
+  stiff(1, 1) = 1e-6;
+  stiff_large(0, 0) = stiff_large(1, 1) = 1e12;
+  stiff_large(2, 2) = stiff_large(3, 3) = 1e-6;
+  EXPECT_THROW(stiff.InverseMatrix(), std::length_error);
+  EXPECT_THROW(stiff_large.InverseMatrix(), std::length_error);
+  EXPECT_THROW(stiff_large.InverseMatrix(spd), std::length_error);
+  EXPECT_THROW(stiff_large.Solve(S21Matrix(4, 1)), std::length_error);
+  EXPECT_THROW(stiff_large.Solve(S21Matrix(4, 1), spd), std::length_error);
+}
+
 TEST(SumOperator, test_30) {
   S21Matrix a(3, 3);
   a(0, 0) = 2.0;
@@ -1248,7 +1453,1482 @@ TEST(Construct, moveMatrix) {
   EXPECT_TRUE(result == dop);
 }
 
+TEST(Storage, mutateKeepsValues) {
+  S21Matrix a(3, 4);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 4; j++) {
+      a(i, j) = i * 10 + j;
+    }
+  }
+  S21Matrix b(a);
+  b.MutateCols(2);
+  b.MutateRows(5);
+  b.MutateCols(6);
+
+  EXPECT_EQ(b.AccessRows(), 5);
+  EXPECT_EQ(b.AccessCols(), 6);
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 6; j++) {
+      double expected = (i < 3 && j < 2) ? a(i, j) : 0.0;
+      EXPECT_DOUBLE_EQ(b(i, j), expected);
+    }
+  }
+}
+
+TEST(Simd, everyIsaMatchesScalar) {
+  S21Matrix a(37, 203);
+  S21Matrix b(203, 41);
+  for (int i = 0; i < a.AccessRows(); i++) {
+    for (int j = 0; j < a.AccessCols(); j++) {
+      a(i, j) = ((i * 7 + j * 3) % 19) / 19.0 - 0.5;
+    }
+  }
+  for (int i = 0; i < b.AccessRows(); i++) {
+    for (int j = 0; j < b.AccessCols(); j++) {
+      b(i, j) = ((i * 2 + j * 5) % 17) / 17.0 - 0.5;
+    }
+  }
+
+  const S21Isa detected = S21ActiveIsa();
+  EXPECT_EQ(S21SelectIsa(S21Isa::kScalar), S21Isa::kScalar);
+  EXPECT_STREQ(S21IsaName(S21ActiveIsa()), "scalar");
+  S21Matrix sum = a + a * 0.5;
+  S21Matrix diff = a - a * 3.0;
+  S21Matrix product = a * b;
+
+  for (S21Isa isa : {S21Isa::kSse2, S21Isa::kAvx2, S21Isa::kAvx512}) {
+    S21SelectIsa(isa);
+    EXPECT_TRUE(sum == a + a * 0.5) << S21IsaName(S21ActiveIsa());
+    EXPECT_TRUE(diff == a - a * 3.0) << S21IsaName(S21ActiveIsa());
+    EXPECT_TRUE(product == a * b) << S21IsaName(S21ActiveIsa());
+    S21Matrix shifted(a);
+    shifted(36, 202) += 1e-3;
+    EXPECT_FALSE(shifted == a) << S21IsaName(S21ActiveIsa());
+  }
+  EXPECT_EQ(S21SelectIsa(detected), detected);
+}
+
+TEST(ThreadPool, runsEveryTask) {
+  const int threads = S21ThreadCount();
+  S21SetThreadCount(4);
+  EXPECT_EQ(S21ThreadCount(), 4);
+
+  std::vector<std::atomic<int>> hits(1000);
+  S21ThreadPool::Instance().Run(1000, [&](int i) {
+    S21ParallelFor(0, 10, 1, [&](int begin, int end) {
+      for (int j = begin; j < end; j++) {
+        hits[i] += j;
+      }
+    });
+  });
+  for (const auto& hit : hits) {
+    EXPECT_EQ(hit, 45);
+  }
+  S21SetThreadCount(threads);
+}
+
+TEST(ThreadPool, rethrowsOnCaller) {
+  const int threads = S21ThreadCount();
+  S21SetThreadCount(4);
+  std::atomic<int> started{0};
+  EXPECT_THROW(S21ThreadPool::Instance().Run(1000,
+                                             [&](int i) {
+                                               started++;
+                                               if (i % 100 == 7) {
+                                                 throw std::bad_alloc();
+                                               }
+                                             }),
+               std::bad_alloc);
+  EXPECT_LT(started, 1000);
+  EXPECT_THROW(S21ParallelFor(0, 1 << 12, 1,
+                              [](int begin, int) {
+                                if (begin > 0) {
+                                  throw std::length_error("chunk");
+                                }
+                              }),
+               std::length_error);
+
+  // The pool is still usable afterwards.
+  std::atomic<int> sum{0};
+  S21ThreadPool::Instance().Run(100, [&](int i) { sum += i; });
+  EXPECT_EQ(sum, 4950);
+  S21SetThreadCount(threads);
+}
+
+TEST(ThreadPool, parallelMatchesSerial) {
+  const int threads = S21ThreadCount();
+  S21Matrix a(300, 260);
+  S21Matrix b(260, 310);
+  S21Matrix square(300, 300);
+  for (int i = 0; i < a.AccessRows(); i++) {
+    for (int j = 0; j < a.AccessCols(); j++) {
+      a(i, j) = ((i * 7 + j * 3) % 19) / 19.0 - 0.5;
+    }
+  }
+  for (int i = 0; i < b.AccessRows(); i++) {
+    for (int j = 0; j < b.AccessCols(); j++) {
+      b(i, j) = ((i * 2 + j * 5) % 17) / 17.0 - 0.5;
+    }
+  }
+  for (int i = 0; i < square.AccessRows(); i++) {
+    for (int j = 0; j < square.AccessCols(); j++) {
+      square(i, j) = ((i * 3 + j * 11) % 23) / 23.0 + (i == j ? 4.0 : 0.0);
+    }
+  }
+
+  S21SetThreadCount(1);
+  S21Matrix product = a * b;
+  S21Matrix inverse = square.InverseMatrix();
+  double det = square.Determinant();
+
+  S21SetThreadCount(4);
+  EXPECT_TRUE(product == a * b);
+  EXPECT_TRUE(inverse == square.InverseMatrix());
+  EXPECT_NEAR(square.Determinant() / det, 1.0, 1e-9);
+  S21SetThreadCount(threads);
+}
+
+TEST(Expression, fusedArithmetic) {
+  S21Matrix a(3, 4);
+  S21Matrix b(3, 4);
+  S21Matrix d(3, 4);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 4; j++) {
+      a(i, j) = i + j;
+      b(i, j) = i * j - 1.5;
+      d(i, j) = 0.25 * j;
+    }
+  }
+
+  S21Matrix result = a + b * 2.0 - d;
+  S21Matrix reused(3, 4);
+  const double* storage = &reused(0, 0);
+  reused = 0.5 * (a - d) + b;
+  const S21Matrix& const_a = a;
+  S21Matrix from_const = const_a * 3.0;
+
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 4; j++) {
+      EXPECT_DOUBLE_EQ(result(i, j), a(i, j) + b(i, j) * 2.0 - d(i, j));
+      EXPECT_DOUBLE_EQ(reused(i, j), 0.5 * (a(i, j) - d(i, j)) + b(i, j));
+      EXPECT_DOUBLE_EQ(from_const(i, j), a(i, j) * 3.0);
+    }
+  }
+  EXPECT_EQ(&reused(0, 0), storage);
+
+  a += b * 2.0 - d;
+  EXPECT_TRUE(a == result);
+  a -= b * 2.0;
+  EXPECT_TRUE(a + d == b * 0.0 + result - b * 2.0 + d);
+}
+
+TEST(Expression, dimensionErrors) {
+  S21Matrix a(3, 4);
+  S21Matrix b(4, 3);
+  S21Matrix empty;
+  EXPECT_THROW(a + b, std::length_error);
+  EXPECT_THROW(a - b * 2.0, std::length_error);
+  EXPECT_THROW(empty * 2.0, std::length_error);
+  EXPECT_THROW(a * a, std::length_error);
+}
+
+TEST(Allocation, temporariesAreReused) {
+  S21Matrix a(6, 7);
+  S21Matrix b(7, 7);
+  S21Matrix c(6, 7);
+  S21Matrix d(6, 7);
+  for (int i = 0; i < 7; i++) {
+    for (int j = 0; j < 7; j++) {
+      b(i, j) = (i == j) ? 2.0 : 0.0;
+      if (i < 6) {
+        a(i, j) = i - j;
+        c(i, j) = i * j;
+        d(i, j) = 0.5 * j;
+      }
+    }
+  }
+
+  long before = aligned_allocations;
+  S21Matrix first = (a * b) + c - d * 2.0;
+  EXPECT_EQ(aligned_allocations - before, 1);
+
+  before = aligned_allocations;
+  S21Matrix second = 2.0 * (a * b) * 0.5 + c * 3.0 - (a * b);
+  EXPECT_EQ(aligned_allocations - before, 2);
+
+  before = aligned_allocations;
+  S21Matrix third = c - (a * b);
+  EXPECT_EQ(aligned_allocations - before, 1);
+
+  before = aligned_allocations;
+  S21Matrix fourth = a + c * 2.0 - d;
+  EXPECT_EQ(aligned_allocations - before, 1);
+
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 7; j++) {
+      EXPECT_DOUBLE_EQ(first(i, j), 2 * a(i, j) + c(i, j) - 2 * d(i, j));
+      EXPECT_DOUBLE_EQ(second(i, j), 3 * c(i, j));
+      EXPECT_DOUBLE_EQ(third(i, j), c(i, j) - 2 * a(i, j));
+      EXPECT_DOUBLE_EQ(fourth(i, j), a(i, j) + 2 * c(i, j) - d(i, j));
+    }
+  }
+}
+
+TEST(FixedMatrix, compileTime) {
+  constexpr S21Matrix2 a({1, 2, 3, 4});
+  constexpr S21Matrix2 b({5, 6, 7, 8});
+  static_assert((a + b)(1, 1) == 12);
+  static_assert((a * b)(0, 1) == 22);
+  static_assert((2.0 * a - b)(1, 0) == -1);
+  static_assert(a.Transpose()(0, 1) == 3);
+  static_assert(a.Determinant() == -2);
+  static_assert(a.InverseMatrix()(1, 0) == 1.5);
+
+  constexpr S21Matrix4 c({2, 0, 0, 1, 0, 3, 0, 0, 0, 0, 4, 0, 1, 0, 0, 2});
+  static_assert(c.Determinant() == 36);
+  static_assert((c * c.InverseMatrix()).EqMatrix(S21Matrix4(
+      {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1})));
+
+  constexpr S21FixedMatrix<2, 3> d({1, 2, 3, 4, 5, 6});
+  constexpr S21FixedMatrix<2, 2> e = d * d.Transpose();
+  static_assert(e(0, 0) == 14 && e(0, 1) == 32 && e(1, 1) == 77);
+}
+
+TEST(FixedMatrix, matchesDynamic) {
+  S21Matrix m(5, 5);
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      m(i, j) = ((i * 7 + j * 3) % 11) - 5 + (i == j ? 9 : 0);
+    }
+  }
+  S21FixedMatrix<5, 5> f(m);
+  EXPECT_NEAR(f.Determinant(), m.Determinant(), 1e-7);
+  EXPECT_TRUE(static_cast<S21Matrix>(f.InverseMatrix()) == m.InverseMatrix());
+  EXPECT_TRUE(static_cast<S21Matrix>(f * f) == m * m);
+  EXPECT_TRUE(static_cast<S21Matrix>(f.Transpose()) == m.Transpose());
+
+  S21Matrix3 g({1, 2, 3, 0, 1, 4, 5, 6, 0});
+  S21Matrix h = static_cast<S21Matrix>(g);
+  EXPECT_TRUE(static_cast<S21Matrix>(g.CalcComplements()) ==
+              h.CalcComplements());
+  EXPECT_TRUE(static_cast<S21Matrix>(g.InverseMatrix()) == h.InverseMatrix());
+}
+
+TEST(FixedMatrix, errors) {
+  S21Matrix m(2, 3);
+  EXPECT_THROW((S21Matrix2(m)), std::length_error);
+  S21Matrix2 singular({1, 2, 2, 4});
+  EXPECT_THROW(singular.InverseMatrix(), std::length_error);
+  S21Matrix4 zero;
+  EXPECT_THROW(zero.InverseMatrix(), std::length_error);
+  EXPECT_THROW(singular(2, 0), std::length_error);
+}
+
+TEST(Allocation, smallMatricesStayInline) {
+  const long before = aligned_allocations;
+  S21Matrix a(4, 4);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      a(i, j) = i * 4 + j;
+    }
+  }
+  S21Matrix b(a);
+  S21Matrix c(std::move(b));
+  S21Matrix d(2, 8);
+  d = std::move(c);
+  c = d;
+  S21Matrix e = a + c * 2.0;
+  e.MulMatrix(a);
+  EXPECT_EQ(aligned_allocations - before, 0);
+
+  EXPECT_EQ(b.AccessRows(), 0);
+  EXPECT_THROW(b(0, 0), std::length_error);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      EXPECT_DOUBLE_EQ(c(i, j), i * 4 + j);
+      EXPECT_DOUBLE_EQ(d(i, j), i * 4 + j);
+    }
+  }
+  EXPECT_TRUE(e == 3.0 * (a * a));
+
+  S21Matrix big(5, 5);
+  big(4, 4) = 1;
+  d = std::move(big);
+  d.MutateRows(3);
+  d.MutateCols(4);
+  EXPECT_EQ(aligned_allocations - before, 1);
+  big = std::move(d);
+  EXPECT_EQ(big.AccessRows(), 3);
+  EXPECT_EQ(big.AccessCols(), 4);
+  EXPECT_DOUBLE_EQ(big(2, 3), 0);
+}
+
+TEST(Arena, releasesToMark) {
+  S21Arena& arena = S21Arena::Local();
+  const S21Arena::Mark start = arena.GetMark();
+  double* first = arena.Allocate<double>(3);
+  const S21Arena::Mark mark = arena.GetMark();
+  int* second = arena.Allocate<int>(1 << 20);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(first) % 64, 0u);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(second) % 64, 0u);
+  second[(1 << 20) - 1] = 1;
+  arena.Release(mark);
+  EXPECT_EQ(arena.Allocate<int>(1 << 20), second);
+  arena.Release(start);
+  double* scoped = nullptr;
+  {
+    S21ArenaScope scratch;
+    scoped = scratch.Allocate<double>(1);
+  }
+  EXPECT_EQ(arena.Allocate<double>(1), scoped);
+  EXPECT_GE(arena.Capacity(), sizeof(int) << 20);
+  arena.Release(start);
+}
+
+TEST(Allocation, scratchComesFromArena) {
+  S21Matrix a(100, 100);
+  for (int i = 0; i < 100; i++) {
+    for (int j = 0; j < 100; j++) {
+      a(i, j) = ((i * 37 + j * 11) % 19) - 9 + (i == j ? 50 : 0);
+    }
+  }
+  S21Matrix b(a);
+  b.MulMatrix(a);
+  S21Matrix warm_up = a.CalcComplements();
+  warm_up = a.InverseMatrix();
+  a.Determinant();
+
+  const long before = aligned_allocations;
+  const double det = a.Determinant();
+  EXPECT_EQ(aligned_allocations - before, 0);
+  b.MulMatrix(a);
+  EXPECT_EQ(aligned_allocations - before, 1);
+  S21Matrix complements = a.CalcComplements();
+  EXPECT_EQ(aligned_allocations - before, 2);
+  S21Matrix inverse = a.InverseMatrix();
+  EXPECT_EQ(aligned_allocations - before, 3);
+
+  EXPECT_NEAR(det / S21LU(a).Determinant(), 1, 1e-9);
+  S21Matrix identity = a * inverse;
+  S21Matrix scaled = a * complements.Transpose();
+  for (int i = 0; i < 100; i++) {
+    EXPECT_NEAR(identity(i, i), 1, 1e-9);
+    EXPECT_NEAR(scaled(i, i) / det, 1, 1e-9);
+  }
+}
+
+TEST(Allocation, pooledBuffersAreRecycled) {
+  S21BufferPool& pool = S21BufferPool::Instance();
+  pool.Trim();
+  const S21PoolStats start = pool.Stats();
+  EXPECT_EQ(start.bytes_retained, 0u);
+  {
+    S21Matrix a(10, 10, pool);
+    a(9, 9) = 1;
+  }
+  EXPECT_EQ(pool.Stats().misses - start.misses, 1);
+  EXPECT_EQ(pool.Stats().bytes_retained, 128 * sizeof(double));
+
+  const long before = aligned_allocations;
+  for (int i = 0; i < 100; i++) {
+    S21Matrix a(10, 10, pool);
+    S21Matrix b(a);
+    S21Matrix c(b);
+    c += a;
+    EXPECT_DOUBLE_EQ(c(9, 9), 0);
+  }
+  // b shares the buffer of a, and c takes its own once written.
+  EXPECT_EQ(aligned_allocations - before, 1);
+  const S21PoolStats end = pool.Stats();
+  EXPECT_EQ(end.misses - start.misses, 2);
+  EXPECT_EQ(end.hits - start.hits, 199);
+  EXPECT_EQ(end.bytes_retained, 2 * 128 * sizeof(double));
+  pool.Trim();
+  EXPECT_EQ(pool.Stats().bytes_retained, 0u);
+}
+
+TEST(Allocation, processWideAllocator) {
+  S21BufferPool& pool = S21BufferPool::Instance();
+  S21Matrix heap(8, 8);
+  S21SetMatrixAllocator(&pool);
+  EXPECT_EQ(&S21GetMatrixAllocator(), &pool);
+  S21Matrix pooled(8, 8);
+  pooled(7, 7) = 2;
+  S21Matrix moved(std::move(pooled));
+  S21SetMatrixAllocator(nullptr);
+  EXPECT_EQ(&S21GetMatrixAllocator(), &S21HeapAllocator());
+
+  const S21PoolStats start = pool.Stats();
+  moved.MutateRows(9);
+  heap.MutateRows(9);
+  EXPECT_EQ(pool.Stats().hits + pool.Stats().misses,
+            start.hits + start.misses + 1);
+  EXPECT_DOUBLE_EQ(moved(7, 7), 2);
+  pool.Trim();
+}
+
+// Filled by AppendRow(), which hands out no references, so copies of the
+// result share its buffer.
+S21Matrix CountingMatrix(int rows, int cols) {
+  S21Matrix result(0, cols);
+  std::vector<double> row(cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      row[j] = i * cols + j;
+    }
+    result.AppendRow(row.data());
+  }
+  return result;
+}
+
+TEST(View, blocksRowsColumnsAndMinors) {
+  S21Matrix a = CountingMatrix(5, 6);
+  const S21Matrix& b = a;
+  S21ConstMatrixView block = S21ConstMatrixView(b).Block(1, 2, 3, 4);
+  EXPECT_EQ(block.Rows(), 3);
+  EXPECT_EQ(block.Cols(), 4);
+  EXPECT_DOUBLE_EQ(block(2, 3), 23);
+  EXPECT_DOUBLE_EQ(S21MatrixView(a).RowView(4)(0, 5), 29);
+  EXPECT_DOUBLE_EQ(S21MatrixView(a).ColView(1)(3, 0), 19);
+  EXPECT_THROW(block(3, 0), std::length_error);
+  EXPECT_THROW(block.Block(1, 1, 3, 1), std::length_error);
+
+  S21ConstMatrixView minor = S21ConstMatrixView(b).Minor(2, 3);
+  EXPECT_EQ(minor.Rows(), 4);
+  EXPECT_EQ(minor.Cols(), 5);
+  EXPECT_DOUBLE_EQ(minor(1, 2), 8);
+  EXPECT_DOUBLE_EQ(minor(2, 2), 20);
+  EXPECT_DOUBLE_EQ(minor(2, 3), 22);
+  EXPECT_DOUBLE_EQ(minor.Block(1, 2, 3, 2)(1, 1), 22);
+  EXPECT_DOUBLE_EQ(minor.Block(2, 3, 2, 2)(0, 0), 22);
+  EXPECT_THROW(minor.Minor(0, 0), std::length_error);
+
+  S21Matrix copy(minor);
+  EXPECT_EQ(copy.AccessRows(), 4);
+  EXPECT_DOUBLE_EQ(copy(3, 4), 29);
+  EXPECT_TRUE(copy == minor);
+  EXPECT_TRUE(minor.Transpose() == copy.Transpose());
+}
+
+TEST(View, writesThrough) {
+  S21Matrix a = CountingMatrix(4, 4);
+  S21MatrixView view(a);
+  view.Block(0, 0, 2, 2) = view.Block(2, 2, 2, 2) * 2.0;
+  EXPECT_DOUBLE_EQ(a(1, 1), 30);
+  view.ColView(3) += view.ColView(0);
+  EXPECT_DOUBLE_EQ(a(2, 3), 19);
+  view.Minor(0, 0) *= 0.0;
+  EXPECT_DOUBLE_EQ(a(0, 3), 23);
+  EXPECT_DOUBLE_EQ(a(3, 0), 12);
+  EXPECT_DOUBLE_EQ(a(3, 3), 0);
+  EXPECT_THROW(view.RowView(0) = view.ColView(0), std::length_error);
+}
+
+TEST(View, arithmeticAndDecompositions) {
+  S21Matrix a(6, 6);
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 6; j++) {
+      a(i, j) = ((i * 5 + j * 3) % 7) - 3 + (i == j ? 6 : 0);
+    }
+  }
+  S21ConstMatrixView whole(a);
+  S21Matrix complements = a.CalcComplements();
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 6; j++) {
+      const double sign = (i + j) % 2 ? -1 : 1;
+      EXPECT_NEAR(sign * whole.Minor(i, j).Determinant(), complements(i, j),
+                  1e-6);
+    }
+  }
+
+  S21ConstMatrixView minor = whole.Minor(1, 4);
+  S21Matrix copy(minor);
+  EXPECT_NEAR(minor.Determinant(), copy.Determinant(), 1e-9);
+  EXPECT_TRUE(minor.InverseMatrix() == copy.InverseMatrix());
+  EXPECT_TRUE(minor.CalcComplements() == copy.CalcComplements());
+  EXPECT_NEAR(S21LU(minor).Determinant(), copy.Determinant(), 1e-9);
+  EXPECT_TRUE(minor * whole.Block(0, 0, 5, 2) ==
+              copy * S21Matrix(whole.Block(0, 0, 5, 2)));
+  EXPECT_TRUE(a * whole.ColView(2) == a * S21Matrix(whole.ColView(2)));
+  EXPECT_TRUE(minor + copy == copy * 2.0);
+
+  S21Matrix sum(copy);
+  sum.SumMatrix(minor);
+  sum.SubMatrix(whole.Block(1, 1, 5, 5));
+  sum -= minor;
+  EXPECT_TRUE(sum == copy - S21Matrix(whole.Block(1, 1, 5, 5)));
+  sum.MulMatrix(minor);
+  EXPECT_TRUE(sum == (copy - S21Matrix(whole.Block(1, 1, 5, 5))) * copy);
+  EXPECT_THROW(sum.SumMatrix(whole), std::length_error);
+  EXPECT_THROW(whole.Block(0, 0, 2, 3).Determinant(), std::length_error);
+
+  a.Determinant();
+  const long before = aligned_allocations;
+  EXPECT_NEAR(whole.Minor(0, 0).Determinant(), complements(0, 0), 1e-6);
+  EXPECT_EQ(aligned_allocations - before, 0);
+
+  const double corner = a(2, 3);
+  a = whole.Block(1, 1, 2, 3);
+  EXPECT_EQ(a.AccessRows(), 2);
+  EXPECT_DOUBLE_EQ(a(1, 2), corner);
+}
+
+TEST(Transpose, isLazyView) {
+  S21Matrix a = CountingMatrix(40, 30);
+  const long before = aligned_allocations;
+  S21ConstMatrixView t = a.Transpose();
+  EXPECT_EQ(aligned_allocations - before, 0);
+  EXPECT_EQ(t.Rows(), 30);
+  EXPECT_DOUBLE_EQ(t(29, 39), a(39, 29));
+  EXPECT_TRUE(t.Transpose() == a);
+  a(39, 29) = -1;
+  EXPECT_DOUBLE_EQ(t(29, 39), -1);
+
+  S21Matrix copy = a.Transpose();
+  EXPECT_EQ(aligned_allocations - before, 1);
+  EXPECT_DOUBLE_EQ(copy(5, 7), a(7, 5));
+  S21Matrix product = CountingMatrix(2, 3) * CountingMatrix(3, 2);
+  S21Matrix temporary = S21Matrix(product * 1.0 + product).Transpose();
+  EXPECT_DOUBLE_EQ(temporary(0, 1), 2 * product(1, 0));
+  S21Matrix moved = S21Matrix(product).Transpose();
+  EXPECT_DOUBLE_EQ(moved(1, 0), product(0, 1));
+  EXPECT_DOUBLE_EQ(S21MatrixView(a).Minor(1, 2).Transpose()(2, 1),
+                   a(2, 3));
+}
+
+TEST(Transpose, selfAssignment) {
+  S21Matrix a = CountingMatrix(4, 4);
+  const S21Matrix original(a);
+  a = a.Transpose();
+  EXPECT_TRUE(a == original.Transpose());
+  a += a.Transpose();
+  EXPECT_TRUE(a == original + original.Transpose());
+  a.SubMatrix(a.Transpose() * 0.5);
+  a.SumMatrix(a.Transpose());
+  EXPECT_TRUE(a == original + original.Transpose());
+
+  S21Matrix b = CountingMatrix(3, 5);
+  b = b.Transpose();
+  EXPECT_EQ(b.AccessRows(), 5);
+  EXPECT_DOUBLE_EQ(b(4, 2), 14);
+
+  S21Matrix c = CountingMatrix(5, 5);
+  S21MatrixView view(c);
+  view.Block(0, 0, 3, 3) = view.Block(1, 1, 3, 3).Transpose();
+  EXPECT_DOUBLE_EQ(c(0, 2), 16);
+  EXPECT_DOUBLE_EQ(c(2, 0), 8);
+  EXPECT_DOUBLE_EQ(c(2, 2), 18);
+}
+
+TEST(MulMatrix, transposedOperands) {
+  const int sizes[][3] = {{5, 7, 3}, {131, 300, 45}, {70, 9, 260}};
+  for (const auto& size : sizes) {
+    const int m = size[0], k = size[1], n = size[2];
+    S21Matrix a(k, m);
+    S21Matrix b(n, k);
+    for (int i = 0; i < k; i++) {
+      for (int j = 0; j < m; j++) {
+        a(i, j) = ((i * 3 + j * 7) % 13) / 13.0 - 0.5;
+      }
+      for (int j = 0; j < n; j++) {
+        b(j, i) = ((i * 5 + j * 2) % 11) / 11.0 - 0.5;
+      }
+    }
+    S21Matrix a_t = a.Transpose();
+    S21Matrix b_t = b.Transpose();
+    S21Matrix expected = a_t * b_t;
+    for (int flags = 0; flags < 4; flags++) {
+      const bool trans_a = flags & 1, trans_b = flags & 2;
+      S21Matrix& lhs = trans_a ? a : a_t;
+      S21Matrix& rhs = trans_b ? b : b_t;
+      S21Matrix result(m, n);
+      S21Gemm(trans_a, trans_b, m, n, k, 1.0, &lhs(0, 0), lhs.AccessCols(),
+              &rhs(0, 0), rhs.AccessCols(), &result(0, 0), n);
+      EXPECT_TRUE(result == expected);
+    }
+    EXPECT_TRUE(a.Transpose() * b.Transpose() == expected);
+    EXPECT_TRUE(a.Transpose() * b_t == expected);
+    EXPECT_TRUE(a_t * b.Transpose() == expected);
+  }
+
+  S21Matrix a = CountingMatrix(100, 100);
+  a.Transpose() * a;
+  const long before = aligned_allocations;
+  S21Matrix gram = a.Transpose() * a;
+  EXPECT_EQ(aligned_allocations - before, 1);
+  EXPECT_TRUE(gram == gram.Transpose());
+}
+
+TEST(Transpose, inPlace) {
+  const int sizes[][2] = {{1, 1}, {7, 7},   {33, 33}, {100, 100}, {257, 257},
+                          {1, 9}, {9, 1},   {3, 5},   {64, 33},   {40, 130}};
+  for (const auto& size : sizes) {
+    const int rows = size[0], cols = size[1];
+    S21Matrix a(rows, cols);
+    for (int i = 0; i < rows; i++) {
+      for (int j = 0; j < cols; j++) {
+        a(i, j) = i * 1000 + j;
+      }
+    }
+    const S21Matrix expected = a.Transpose();
+    for (int i = 0; i < cols; i++) {
+      for (int j = 0; j < rows; j++) {
+        ASSERT_DOUBLE_EQ(expected(i, j), j * 1000 + i);
+      }
+    }
+    a.TransposeInPlace();
+    EXPECT_EQ(a.AccessRows(), cols);
+    EXPECT_EQ(a.AccessCols(), rows);
+    EXPECT_TRUE(a == expected) << rows << " x " << cols;
+    a.TransposeInPlace();
+    EXPECT_TRUE(a == expected.Transpose()) << rows << " x " << cols;
+  }
+
+  S21Matrix square = CountingMatrix(50, 50);
+  const long before = aligned_allocations;
+  S21Matrix moved = std::move(square).Transpose();
+  EXPECT_EQ(aligned_allocations - before, 0);
+  EXPECT_DOUBLE_EQ(moved(3, 40), 40 * 50 + 3);
+
+  S21Matrix empty;
+  EXPECT_THROW(empty.TransposeInPlace(), std::length_error);
+}
+
+TEST(Transpose, largeOnEveryIsa) {
+  const S21Isa detected = S21ActiveIsa();
+  S21Matrix a(1100, 1000);
+  for (int i = 0; i < 1100; i++) {
+    for (int j = 0; j < 1000; j++) {
+      a(i, j) = i - j * 1e-4;
+    }
+  }
+  for (S21Isa isa : {S21Isa::kScalar, S21Isa::kSse2, S21Isa::kAvx2,
+                     S21Isa::kAvx512}) {
+    S21SelectIsa(isa);
+    S21Matrix t = a.Transpose();
+    bool equal = true;
+    for (int i = 0; i < 1000 && equal; i++) {
+      for (int j = 0; j < 1100 && equal; j++) {
+        equal = t(i, j) == a(j, i);
+      }
+    }
+    EXPECT_TRUE(equal) << S21IsaName(S21ActiveIsa());
+  }
+  S21SelectIsa(detected);
+}
+
+TEST(CopyOnWrite, copiesShareUntilWritten) {
+  S21Matrix a = CountingMatrix(100, 100);
+  const S21Matrix& original = a;
+  const long before = aligned_allocations;
+  S21Matrix b(a);
+  S21Matrix c;
+  c = b;
+  const S21Matrix& read = c;
+  EXPECT_DOUBLE_EQ(read(99, 98), 9998);
+  EXPECT_TRUE(read == a);
+  EXPECT_EQ(aligned_allocations - before, 0);
+
+  b(0, 0) = -1;
+  EXPECT_EQ(aligned_allocations - before, 1);
+  EXPECT_DOUBLE_EQ(b(0, 0), -1);
+  EXPECT_DOUBLE_EQ(original(0, 0), 0);
+  EXPECT_DOUBLE_EQ(read(0, 0), 0);
+  b(0, 1) = -2;
+  EXPECT_EQ(aligned_allocations - before, 1);
+
+  a.MulNumber(2);
+  EXPECT_EQ(aligned_allocations - before, 2);
+  EXPECT_DOUBLE_EQ(read(1, 1), 101);
+  c.SumMatrix(a);
+  EXPECT_EQ(aligned_allocations - before, 2);
+  EXPECT_DOUBLE_EQ(c(1, 1), 303);
+
+  S21Matrix d(a);
+  d += d;
+  EXPECT_DOUBLE_EQ(d(1, 1), 404);
+  EXPECT_DOUBLE_EQ(a(1, 1), 202);
+  S21Matrix e(a);
+  e = e * 0.5 + a;
+  EXPECT_DOUBLE_EQ(e(1, 1), 303);
+  EXPECT_DOUBLE_EQ(a(1, 1), 202);
+  S21Matrix f(a);
+  S21MatrixView(f).Block(1, 1, 2, 2) *= 0;
+  EXPECT_DOUBLE_EQ(f(1, 1), 0);
+  EXPECT_DOUBLE_EQ(a(1, 1), 202);
+  S21Matrix g(a);
+  g.TransposeInPlace();
+  EXPECT_DOUBLE_EQ(g(1, 0), a(0, 1));
+  EXPECT_DOUBLE_EQ(a(1, 0), 200);
+}
+
+TEST(CopyOnWrite, reassignAfterResize) {
+  const S21Matrix a = CountingMatrix(10, 10);
+  S21Matrix b = a;
+  b.MutateRows(2);
+  b = a;
+  EXPECT_EQ(b.AccessRows(), 10);
+  EXPECT_TRUE(b == a);
+  b.MutateCols(3);
+  b = a;
+  EXPECT_EQ(b.AccessCols(), 10);
+  EXPECT_TRUE(b == a);
+}
+
+TEST(CopyOnWrite, referencesOutliveCopies) {
+  // Writes through a reference or view taken before the copy must not
+  // reach the copy.
+  S21Matrix a = CountingMatrix(10, 10);
+  double& element = a(0, 0);
+  S21Matrix b(a);
+  S21Matrix b_assigned;
+  b_assigned = a;
+  element = 42;
+  EXPECT_DOUBLE_EQ(b(0, 0), 0);
+  EXPECT_DOUBLE_EQ(b_assigned(0, 0), 0);
+  EXPECT_DOUBLE_EQ(a(0, 0), 42);
+
+  S21Matrix c = CountingMatrix(10, 10);
+  S21MatrixView view(c);
+  S21Matrix d(c);
+  view(1, 1) = 7;
+  EXPECT_DOUBLE_EQ(d(1, 1), 11);
+  EXPECT_DOUBLE_EQ(c(1, 1), 7);
+
+  // The pin moves with the buffer and goes with it.
+  S21Matrix moved(std::move(c));
+  S21Matrix e(moved);
+  view(2, 2) = 8;
+  EXPECT_DOUBLE_EQ(e(2, 2), 22);
+  EXPECT_DOUBLE_EQ(moved(2, 2), 8);
+  moved = CountingMatrix(10, 10);
+  const long before = aligned_allocations;
+  S21Matrix f(moved);
+  EXPECT_EQ(aligned_allocations - before, 0);
+}
+
+TEST(CopyOnWrite, threadsCopyOneMatrix) {
+  const S21Matrix source = CountingMatrix(64, 64);
+  std::vector<std::thread> threads;
+  std::vector<double> sums(8);
+  for (int t = 0; t < 8; t++) {
+    threads.emplace_back([&source, &sums, t] {
+      for (int k = 0; k < 200; k++) {
+        S21Matrix copy(source);
+        S21Matrix second(copy);
+        copy(0, 0) = t;
+        sums[t] += copy(0, 0) + second(63, 63);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (int t = 0; t < 8; t++) {
+    EXPECT_DOUBLE_EQ(sums[t], 200.0 * (t + 4095));
+  }
+  EXPECT_DOUBLE_EQ(source(0, 0), 0);
+}
+
+TEST(Storage, appendRowsGrowGeometrically) {
+  S21Matrix samples(0, 8);
+  double row[8];
+  const long before = aligned_allocations;
+  for (int i = 0; i < 1000; i++) {
+    for (int j = 0; j < 8; j++) {
+      row[j] = i * 8 + j;
+    }
+    samples.AppendRow(row);
+  }
+  EXPECT_LE(aligned_allocations - before, 10);
+  EXPECT_EQ(samples.AccessRows(), 1000);
+  EXPECT_TRUE(samples == CountingMatrix(1000, 8));
+
+  S21Matrix tail = CountingMatrix(2, 8);
+  samples.AppendRows(&tail(0, 0), 2);
+  EXPECT_DOUBLE_EQ(samples(1001, 7), 15);
+  samples.ShrinkToFit();
+  samples.AppendRows(&samples(0, 0), 3);
+  EXPECT_EQ(samples.AccessRows(), 1005);
+  EXPECT_DOUBLE_EQ(samples(1004, 7), 23);
+
+  S21Matrix empty;
+  EXPECT_THROW(empty.AppendRow(row), std::length_error);
+  EXPECT_THROW(samples.AppendRows(row, -1), std::length_error);
+  EXPECT_THROW(samples.Reserve(-1, 2), std::length_error);
+}
+
+TEST(Storage, resizeSharedCopies) {
+  // Copies share the buffer, spare capacity included; growing one must
+  // not write into the other's.
+  double row[5] = {1, 2, 3, 4, 5};
+  S21Matrix reserved(2, 5);
+  reserved.Reserve(50, 5);
+  const S21Matrix original = reserved;
+  S21Matrix appended = reserved;
+  appended.AppendRow(row);
+  appended.AppendRow(row);
+  EXPECT_EQ(appended.AccessRows(), 4);
+  EXPECT_DOUBLE_EQ(appended(3, 4), 5);
+  EXPECT_EQ(reserved.AccessRows(), 2);
+  EXPECT_TRUE(reserved == original);
+
+  const S21Matrix a = CountingMatrix(10, 10);
+  S21Matrix rows = a;
+  rows.MutateRows(1);
+  rows.MutateRows(10);
+  S21Matrix cols = a;
+  cols.MutateCols(1);
+  cols.MutateCols(10);
+  for (int i = 0; i < 10; i++) {
+    for (int j = 0; j < 10; j++) {
+      EXPECT_DOUBLE_EQ(rows(i, j), i == 0 ? a(i, j) : 0);
+      EXPECT_DOUBLE_EQ(cols(i, j), j == 0 ? a(i, j) : 0);
+    }
+  }
+  EXPECT_DOUBLE_EQ(a(9, 9), 99);
+}
+
+TEST(Storage, reserveAndShrinkInPlace) {
+  S21Matrix a(0, 8);
+  a.Reserve(100, 8);
+  const long before = aligned_allocations;
+  const double row[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+  for (int i = 0; i < 100; i++) {
+    a.AppendRow(row);
+  }
+  a.MutateRows(10);
+  a.MutateCols(3);
+  EXPECT_EQ(aligned_allocations - before, 0);
+  a.MutateCols(8);
+  a.MutateRows(60);
+  EXPECT_EQ(aligned_allocations - before, 0);
+  EXPECT_DOUBLE_EQ(a(9, 2), 2);
+  EXPECT_DOUBLE_EQ(a(9, 3), 0);
+  EXPECT_DOUBLE_EQ(a(59, 0), 0);
+
+  a.ShrinkToFit();
+  EXPECT_EQ(aligned_allocations - before, 1);
+  a.ShrinkToFit();
+  EXPECT_EQ(aligned_allocations - before, 1);
+  EXPECT_DOUBLE_EQ(a(9, 2), 2);
+  EXPECT_DOUBLE_EQ(a(10, 2), 0);
+}
+
+TEST(Storage, paddedRowsBehaveLikeDense) {
+  S21Matrix a = CountingMatrix(10, 12);
+  a.MutateCols(7);
+  S21Matrix dense(10, 7);
+  for (int i = 0; i < 10; i++) {
+    for (int j = 0; j < 7; j++) {
+      dense(i, j) = i * 12 + j;
+    }
+  }
+  EXPECT_TRUE(a == dense);
+  EXPECT_TRUE(a + a == dense * 2.0);
+  EXPECT_TRUE(a * a.Transpose() == dense * dense.Transpose());
+  S21Matrix copy(a);
+  copy.MulNumber(-1);
+  EXPECT_TRUE(copy == dense * -1.0);
+  a.TransposeInPlace();
+  EXPECT_TRUE(a == dense.Transpose());
+  S21Matrix square = CountingMatrix(9, 9);
+  square(0, 0) = 1;
+  square.MutateCols(4);
+  square.MutateRows(4);
+  S21Matrix expected = CountingMatrix(4, 4);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      expected(i, j) = i * 9 + j + (i + j == 0);
+    }
+  }
+  EXPECT_DOUBLE_EQ(square.Determinant(), expected.Determinant());
+}
+
+// Reference determinant by cofactor expansion along the first row.
+std::int64_t LaplaceDeterminant(const S21Int64Matrix& a) {
+  const int n = a.AccessRows();
+  std::int64_t det = n == 1 ? a(0, 0) : 0;
+  for (int j = 0; j < n && n > 1; j++) {
+    const S21Int64Matrix minor(
+        S21BasicMatrixView<const std::int64_t>(a).Minor(0, j));
+    det += (j % 2 ? -a(0, j) : a(0, j)) * LaplaceDeterminant(minor);
+  }
+  return det;
+}
+
+// Elements in [-range, range] from a linear congruential generator.
+S21Int64Matrix PseudoRandomInt64(int rows, int cols, int range) {
+  S21Int64Matrix result(rows, cols);
+  std::uint64_t state = rows * 1000 + cols;
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      state = state * 6364136223846793005u + 1442695040888963407u;
+      const std::uint64_t draw = (state >> 33) % (2 * range + 1);
+      result(i, j) = static_cast<std::int64_t>(draw) - range;
+    }
+  }
+  return result;
+}
+
+TEST(ElementType, floatMatchesDouble) {
+  const S21Isa detected = S21ActiveIsa();
+  S21Matrix a(37, 203);
+  S21Matrix b(203, 41);
+  for (int i = 0; i < a.AccessRows(); i++) {
+    for (int j = 0; j < a.AccessCols(); j++) {
+      a(i, j) = ((i * 7 + j * 3) % 19) / 19.0 - 0.5;
+    }
+  }
+  for (int i = 0; i < b.AccessRows(); i++) {
+    for (int j = 0; j < b.AccessCols(); j++) {
+      b(i, j) = ((i * 2 + j * 5) % 17) / 17.0 - 0.5;
+    }
+  }
+  const S21FloatMatrix fa(a);
+  const S21FloatMatrix fb(b);
+  const S21Matrix product = a * b;
+  for (S21Isa isa : {S21Isa::kScalar, S21Isa::kSse2, S21Isa::kAvx2,
+                     S21Isa::kAvx512}) {
+    S21SelectIsa(isa);
+    EXPECT_TRUE(S21FloatMatrix(S21Matrix(a + a * 0.5)) == fa + fa * 0.5f)
+        << S21IsaName(S21ActiveIsa());
+    const S21Matrix fproduct(S21FloatMatrix(fa * fb));
+    double error = 0;
+    for (int i = 0; i < 37; i++) {
+      for (int j = 0; j < 41; j++) {
+        error = std::max(error, std::fabs(fproduct(i, j) - product(i, j)));
+      }
+    }
+    EXPECT_LT(error, 1e-4) << S21IsaName(S21ActiveIsa());
+    EXPECT_TRUE(S21FloatMatrix(S21Matrix(a.Transpose())) == fa.Transpose())
+        << S21IsaName(S21ActiveIsa());
+    S21FloatMatrix shifted(fa);
+    shifted(36, 202) += 1e-3f;
+    EXPECT_FALSE(shifted == fa) << S21IsaName(S21ActiveIsa());
+  }
+  S21SelectIsa(detected);
+
+  for (int n : {3, 6}) {
+    S21Matrix m(n, n);
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
+        m(i, j) = (i == j) * n + ((i * 5 + j * 3) % 7) / 7.0;
+      }
+    }
+    S21FloatMatrix fm(m);
+    EXPECT_NEAR(fm.Determinant() / m.Determinant(), 1, 1e-5);
+    S21FloatMatrix identity(n, n);
+    for (int i = 0; i < n; i++) {
+      identity(i, i) = 1;
+    }
+    EXPECT_TRUE(fm * fm.InverseMatrix() == identity);
+    const S21Matrix complements = m.CalcComplements();
+    const S21Matrix fcomplements(fm.CalcComplements());
+    double error = 0, largest = 0;
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
+        error = std::max(error,
+                         std::fabs(fcomplements(i, j) - complements(i, j)));
+        largest = std::max(largest, std::fabs(complements(i, j)));
+      }
+    }
+    EXPECT_LT(error, largest * 1e-5);
+  }
+}
+
+TEST(ElementType, int64IsExact) {
+  const S21Isa detected = S21ActiveIsa();
+  const std::int64_t big = (1L << 53) + 1;
+  const S21Int64Matrix a = PseudoRandomInt64(40, 40, 1 << 26);
+  const S21Int64Matrix b = PseudoRandomInt64(40, 40, 1 << 26);
+  S21Int64Matrix shifted(a);
+  shifted(0, 0) = big;
+  for (S21Isa isa : {S21Isa::kScalar, S21Isa::kSse2, S21Isa::kAvx2,
+                     S21Isa::kAvx512}) {
+    S21SelectIsa(isa);
+    S21Int64Matrix sum = shifted + b * 3 - b;
+    EXPECT_EQ(sum(0, 0), big + 2 * b(0, 0)) << S21IsaName(S21ActiveIsa());
+    const S21Int64Matrix product = a * b.Transpose();
+    bool equal = true;
+    for (int i = 0; i < 40 && equal; i++) {
+      for (int j = 0; j < 40 && equal; j++) {
+        std::int64_t expected = 0;
+        for (int k = 0; k < 40; k++) {
+          expected += a(i, k) * b(j, k);
+        }
+        equal = product(i, j) == expected;
+      }
+    }
+    EXPECT_TRUE(equal) << S21IsaName(S21ActiveIsa());
+  }
+  S21SelectIsa(detected);
+
+  S21Int64Matrix m = PseudoRandomInt64(5, 5, 3000);
+  const std::int64_t det = LaplaceDeterminant(m);
+  EXPECT_GT(std::abs(det), 1L << 53);
+  EXPECT_EQ(m.Determinant(), det);
+  const S21Int64Matrix complements = m.CalcComplements();
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      const std::int64_t minor = LaplaceDeterminant(S21Int64Matrix(
+          S21BasicMatrixView<const std::int64_t>(m).Minor(i, j)));
+      EXPECT_EQ(complements(i, j), (i + j) % 2 ? -minor : minor);
+    }
+  }
+  for (int j = 0; j < 5; j++) {
+    m(4, j) = m(0, j) - 2 * m(1, j);
+  }
+  EXPECT_EQ(m.Determinant(), 0);
+  const S21Int64Matrix singular = m.CalcComplements();
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      const std::int64_t minor = LaplaceDeterminant(S21Int64Matrix(
+          S21BasicMatrixView<const std::int64_t>(m).Minor(i, j)));
+      EXPECT_EQ(singular(i, j), (i + j) % 2 ? -minor : minor);
+    }
+  }
+  EXPECT_THROW(m.InverseMatrix(), std::length_error);
+
+  // Unit triangular factors give determinant 1, and swapping two rows -1.
+  S21Int64Matrix lower(6, 6), upper(6, 6), identity(6, 6);
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 6; j++) {
+      lower(i, j) = i > j ? (i * 3 + j) % 5 - 2 : i == j;
+      upper(i, j) = i < j ? (i + j * 7) % 9 - 4 : i == j;
+    }
+    identity(i, i) = 1;
+  }
+  S21Int64Matrix unimodular = lower * upper;
+  EXPECT_EQ(unimodular.Determinant(), 1);
+  EXPECT_TRUE(unimodular * unimodular.InverseMatrix() == identity);
+  S21Int64Matrix swapped(unimodular);
+  const S21BasicMatrixView<const std::int64_t> rows(unimodular);
+  S21BasicMatrixView<std::int64_t>(swapped).RowView(0) = rows.RowView(1);
+  S21BasicMatrixView<std::int64_t>(swapped).RowView(1) = rows.RowView(0);
+  EXPECT_EQ(swapped.Determinant(), -1);
+  EXPECT_TRUE(swapped.InverseMatrix() * swapped == identity);
+  swapped *= 2;
+  EXPECT_THROW(swapped.InverseMatrix(), std::length_error);
+}
+
+TEST(ElementType, conversions) {
+  S21Matrix a(2, 2);
+  a(0, 0) = 2.7;
+  a(0, 1) = -2.7;
+  a(1, 0) = 1e10 + 1;
+  a(1, 1) = 0.1;
+  const S21Int64Matrix truncated(a);
+  EXPECT_EQ(truncated(0, 0), 2);
+  EXPECT_EQ(truncated(0, 1), -2);
+  EXPECT_EQ(truncated(1, 0), 10000000001);
+  EXPECT_EQ(truncated(1, 1), 0);
+  const S21FloatMatrix narrowed(a);
+  EXPECT_FLOAT_EQ(narrowed(1, 1), 0.1f);
+  EXPECT_FALSE(S21Matrix(narrowed) == a);
+  EXPECT_DOUBLE_EQ(S21Matrix(truncated)(1, 0), 1e10 + 1);
+  S21FloatMatrix tolerant(narrowed);
+  tolerant(0, 0) += 1e-6f;
+  EXPECT_TRUE(tolerant == narrowed);
+  S21Int64Matrix exact(truncated);
+  exact(1, 0) += 1;
+  EXPECT_FALSE(exact == truncated);
+}
+
+TEST(Solve, mixedPrecision) {
+  const int n = 150;
+  S21Matrix a(n, n), x(n, 3);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      a(i, j) = (i == j) * 4 + ((i * 13 + j * 7) % 11) / 11.0 - 0.5;
+    }
+    for (int j = 0; j < 3; j++) {
+      x(i, j) = ((i + 1) * (j + 2) % 23) / 7.0 - 1;
+    }
+  }
+  const S21Matrix b = a * x;
+  const S21Matrix full = a.Solve(b);
+  const S21Matrix mixed = a.Solve(b, S21Precision::kMixed);
+  EXPECT_TRUE(full == x);
+  EXPECT_TRUE(mixed == x);
+  EXPECT_TRUE(a * mixed == b);
+  EXPECT_TRUE(a.Transpose().Solve(a.Transpose() * x, S21Precision::kMixed) ==
+              x);
+
+  // 1 + 1e-9 rounds to 1 in float, so the float factors are singular and
+  // the double factorization takes over.
+  S21Matrix nearly_singular(2, 2);
+  nearly_singular(0, 0) = 1e4;
+  nearly_singular(0, 1) = 1e4;
+  nearly_singular(1, 0) = 1e4;
+  nearly_singular(1, 1) = 1e4 * (1 + 1e-9);
+  S21Matrix rhs(2, 1);
+  rhs(0, 0) = 3e4;
+  rhs(1, 0) = 3e4 + 2e-5;
+  const S21Matrix solution =
+      nearly_singular.Solve(rhs, S21Precision::kMixed);
+  EXPECT_TRUE(nearly_singular * solution == rhs);
+  EXPECT_NEAR(solution(1, 0), 2, 1e-6);
+
+  S21Matrix singular(3, 3);
+  InitMatrix(&singular, 1);
+  EXPECT_THROW(singular.Solve(S21Matrix(3, 1)), std::length_error);
+  EXPECT_THROW(singular.Solve(S21Matrix(3, 1), S21Precision::kMixed),
+               std::length_error);
+  EXPECT_THROW(a.Solve(S21Matrix(n + 1, 1)), std::length_error);
+  EXPECT_THROW(S21Matrix(2, 3).Solve(S21Matrix(2, 1)), std::length_error);
+
+  const S21FloatMatrix fa(a);
+  EXPECT_TRUE(fa.Solve(S21FloatMatrix(b), S21Precision::kMixed) ==
+              S21FloatMatrix(x));
+  S21Int64Matrix ia(3, 3), ib(3, 2);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      ia(i, j) = (i * 3 + j) % 5 + (i == j) * 2;
+    }
+    ib(i, 0) = i - 1;
+    ib(i, 1) = i * i;
+  }
+  const S21Int64Matrix ix = ia.Solve(ia * ib);
+  EXPECT_TRUE(ix == ib);
+  ib(0, 0) = 1;
+  EXPECT_THROW(ia.Solve(ib), std::length_error);
+}
+
+TEST(Solve, manyRightHandSides) {
+  const int n = 203;
+  S21Matrix a(n, n), b(n, 70);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      a(i, j) = ((i * 17 + j * 5) % 29) / 29.0 - 0.5 + (i == j) * 2;
+    }
+    for (int j = 0; j < 70; j++) {
+      b(i, j) = ((i * 3 + j * 11) % 13) / 13.0;
+    }
+  }
+  const S21Matrix x = a.Solve(b);
+  EXPECT_EQ(x.AccessRows(), n);
+  EXPECT_EQ(x.AccessCols(), 70);
+  EXPECT_TRUE(a * x == b);
+  EXPECT_TRUE(x == S21Matrix(a).InverseMatrix() * b);
+  EXPECT_TRUE(a.Solve(b.Transpose().Transpose()) == x);
+  const S21ConstMatrixView block = S21ConstMatrixView(a).Block(0, 0, 100, 100);
+  const S21ConstMatrixView rows = S21ConstMatrixView(b).Block(0, 0, 100, 70);
+  EXPECT_TRUE(block * block.Solve(rows) == rows);
+  const S21Matrix solved = block.Solve(rows);
+  EXPECT_TRUE(block.Solve(rows.ColView(3)) ==
+              S21ConstMatrixView(solved).ColView(3));
+}
+
+TEST(Factorization, reusableObjectsAgree) {
+  const int n = 70;
+  S21Matrix m(n, n), b(n, 3), identity(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      m(i, j) = ((i * 7 + j * 13) % 17) / 17.0 - 0.5;
+    }
+    for (int j = 0; j < 3; j++) {
+      b(i, j) = (i + j) % 5 - 2;
+    }
+    identity(i, i) = 1;
+  }
+  const S21Matrix a = m.Transpose() * m + identity;
+  const double det = a.Determinant();
+  const S21LU lu(a);
+  const S21Cholesky cholesky(a);
+  const S21QR qr(a);
+  EXPECT_NEAR(lu.Determinant() / det, 1, 1e-9);
+  EXPECT_NEAR(cholesky.Determinant() / det, 1, 1e-9);
+  EXPECT_NEAR(qr.Determinant() / det, 1, 1e-9);
+  EXPECT_NEAR(lu.LogAbsDeterminant(), std::log(det), 1e-9);
+  EXPECT_NEAR(cholesky.LogDeterminant(), std::log(det), 1e-9);
+  EXPECT_NEAR(qr.LogAbsDeterminant(), std::log(det), 1e-9);
+  EXPECT_EQ(qr.Rank(), n);
+  const S21Matrix x = a.Solve(b);
+  EXPECT_TRUE(lu.Solve(b) == x);
+  EXPECT_TRUE(cholesky.Solve(b) == x);
+  EXPECT_TRUE(qr.Solve(b) == x);
+  for (int repeat = 0; repeat < 2; repeat++) {
+    EXPECT_TRUE(a * lu.Inverse() == identity);
+    EXPECT_TRUE(a * cholesky.Inverse() == identity);
+    EXPECT_TRUE(a * qr.Inverse() == identity);
+  }
+  const S21Matrix& lower = cholesky.Lower();
+  EXPECT_TRUE(lower * lower.Transpose() == a);
+  EXPECT_DOUBLE_EQ(lower(0, n - 1), 0);
+
+  // Only the lower triangle is read.
+  S21Matrix lower_only(a);
+  for (int i = 0; i < n; i++) {
+    for (int j = i + 1; j < n; j++) {
+      lower_only(i, j) = -1e6;
+    }
+  }
+  EXPECT_TRUE(S21Cholesky(lower_only).Solve(b) == x);
+  S21Matrix indefinite(2, 2);
+  indefinite(0, 0) = indefinite(1, 1) = 1;
+  indefinite(0, 1) = indefinite(1, 0) = 2;
+  EXPECT_THROW(S21Cholesky{indefinite}, std::length_error);
+  EXPECT_THROW(S21Cholesky(S21Matrix(2, 3)), std::length_error);
+  EXPECT_THROW(lu.Solve(S21Matrix(n + 1, 1)), std::length_error);
+}
+
+TEST(Factorization, rankAndLargeDeterminants) {
+  // Rank 3: the last three columns combine the first two and the third.
+  S21Matrix a(6, 6);
+  for (int i = 0; i < 6; i++) {
+    a(i, 0) = i + 1;
+    a(i, 1) = (i * i) % 7;
+    a(i, 2) = i % 2;
+    a(i, 3) = a(i, 0) - a(i, 1);
+    a(i, 4) = 2 * a(i, 2) + a(i, 1);
+    a(i, 5) = a(i, 0) + a(i, 1) + a(i, 2);
+  }
+  const S21QR qr(a);
+  EXPECT_EQ(qr.Rank(), 3);
+  EXPECT_NEAR(qr.Determinant(), 0, 1e-9);
+  EXPECT_THROW(qr.Solve(S21Matrix(6, 1)), std::length_error);
+  EXPECT_THROW(qr.Inverse(), std::length_error);
+  EXPECT_TRUE(S21LU(a).IsSingular());
+  EXPECT_THROW(S21LU(a).Solve(S21Matrix(6, 1)), std::length_error);
+  const S21QR tall(S21ConstMatrixView(a).Block(0, 0, 6, 4));
+  EXPECT_EQ(tall.Rank(), 3);
+  EXPECT_THROW(tall.Determinant(), std::length_error);
+  EXPECT_EQ(S21QR(S21ConstMatrixView(a).Block(0, 0, 2, 6)).Rank(), 2);
+
+  // det = 10^400 overflows, its logarithm does not.
+  S21Matrix big(400, 400);
+  for (int i = 0; i < 400; i++) {
+    big(i, i) = 10;
+    big(i, (i + 1) % 400) = 1;
+  }
+  EXPECT_NEAR(S21LU(big).LogAbsDeterminant(), 400 * std::log(10.0), 1e-6);
+  EXPECT_NEAR(S21QR(big).LogAbsDeterminant(), 400 * std::log(10.0), 1e-6);
+  EXPECT_TRUE(std::isinf(S21LU(big).Determinant()));
+
+  // Solve() goes by the pivots, not by the size of the determinant.
+  S21Matrix half(30, 30), ones(30, 1);
+  for (int i = 0; i < 30; i++) {
+    half(i, i) = 0.5;
+    ones(i, 0) = 1;
+  }
+  EXPECT_TRUE(S21LU(half).Solve(ones) == ones * 2.0);
+  EXPECT_TRUE(S21Cholesky(half).Solve(ones) == ones * 2.0);
+  EXPECT_TRUE(S21QR(half).Solve(ones) == ones * 2.0);
+  EXPECT_FALSE(S21LU(half).IsSingular());
+  S21Matrix stiff(2, 2);
+  stiff(0, 0) = 1e12;
+  stiff(1, 1) = 1e-6;
+  EXPECT_EQ(S21QR(stiff).Rank(), 1);
+  EXPECT_TRUE(S21LU(stiff).IsSingular());
+  EXPECT_THROW(S21LU(stiff).Solve(S21Matrix(2, 1)), std::length_error);
+  EXPECT_THROW(S21Cholesky(stiff).Solve(S21Matrix(2, 1)), std::length_error);
+  EXPECT_THROW(S21QR(stiff).Solve(S21Matrix(2, 1)), std::length_error);
+}
+
+TEST(Factorization, positiveDefiniteHint) {
+  // 200 spans several Cholesky blocks and ends in a partial one.
+  const int threads = S21ThreadCount();
+  const int n = 200;
+  const S21Structure spd = S21Structure::kPositiveDefinite;
+  S21Matrix m(n, n), b(n, 4);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      m(i, j) = ((i * 5 + j * 11) % 23) / 23.0 - 0.5;
+    }
+    for (int j = 0; j < 4; j++) {
+      b(i, j) = (i * 3 + j) % 7 - 3;
+    }
+  }
+  S21Matrix a = m.Transpose() * m;
+  a.MulNumber(1.0 / n);
+  for (int i = 0; i < n; i++) {
+    a(i, i) += 1;
+  }
+
+  S21SetThreadCount(1);
+  const S21Matrix serial = S21Cholesky(a).Lower();
+  S21SetThreadCount(4);
+  const S21Cholesky cholesky(a);
+  EXPECT_TRUE(cholesky.Lower() == serial);
+  EXPECT_TRUE(cholesky.Lower() * cholesky.Lower().Transpose() == a);
+  EXPECT_NEAR(a.Determinant(spd) / a.Determinant(), 1, 1e-9);
+  EXPECT_TRUE(a.Solve(b, spd) == a.Solve(b));
+  S21Matrix inverse = a.InverseMatrix(spd);
+  EXPECT_TRUE(inverse == a.InverseMatrix());
+  const S21ConstMatrixView corner = S21ConstMatrixView(a).Block(0, 0, 70, 70);
+  const S21ConstMatrixView top = S21ConstMatrixView(b).Block(0, 0, 70, 4);
+  EXPECT_TRUE(corner.Solve(top, spd) == S21Matrix(corner).Solve(top));
+  S21SetThreadCount(threads);
+
+  const S21FloatMatrix single(a);
+  EXPECT_NEAR(single.Determinant(spd) / a.Determinant(), 1, 1e-3);
+
+  // The hint is checked, even where a closed form would not need it.
+  S21Matrix indefinite(2, 2);
+  indefinite(0, 0) = indefinite(1, 1) = 1;
+  indefinite(0, 1) = indefinite(1, 0) = 2;
+  EXPECT_DOUBLE_EQ(indefinite.Determinant(), -3);
+  EXPECT_THROW(indefinite.Determinant(spd), std::length_error);
+  EXPECT_THROW(indefinite.InverseMatrix(spd), std::length_error);
+  EXPECT_THROW(indefinite.Solve(S21Matrix(2, 1), spd), std::length_error);
+  S21Int64Matrix exact(2, 2);
+  exact(0, 0) = exact(1, 1) = 1;
+  exact(0, 1) = exact(1, 0) = 2;
+  EXPECT_EQ(exact.Determinant(spd), -3);
+}
+
+TEST(Factorization, leastSquares) {
+  // 5000 rows are split into pieces; 45 columns make two QR blocks.
+  const int threads = S21ThreadCount();
+  const int m = 5000;
+  const int n = 45;
+  S21Matrix a(PseudoRandomInt64(m, n, 50)), x(n, 2), noise(m, 2);
+  a.MulNumber(0.01);
+  for (int i = 0; i < m; i++) {
+    noise(i, 0) = ((i * 11) % 13) / 13.0 - 0.5;
+    noise(i, 1) = ((i * 5) % 7) / 7.0 - 0.5;
+  }
+  for (int j = 0; j < n; j++) {
+    x(j, 0) = j % 5 - 2;
+    x(j, 1) = 1.0 / (j + 1);
+  }
+  const S21Matrix b = a * x;
+  EXPECT_TRUE(a.LeastSquares(b) == x);
+
+  // The residual of the noisy fit is orthogonal to the columns.
+  const S21Matrix noisy = b + noise;
+  S21SetThreadCount(1);
+  const S21Matrix fit = a.LeastSquares(noisy);
+  S21SetThreadCount(4);
+  EXPECT_TRUE(a.LeastSquares(noisy) == fit);
+  S21SetThreadCount(threads);
+  const S21Matrix normal = a.Transpose() * (a * fit - noisy);
+  for (int j = 0; j < n; j++) {
+    EXPECT_NEAR(normal(j, 0), 0, 1e-8);
+    EXPECT_NEAR(normal(j, 1), 0, 1e-8);
+  }
+  EXPECT_TRUE(S21QR(a).LeastSquares(noisy) == fit);
+  const S21ConstMatrixView square = S21ConstMatrixView(a).Block(0, 0, n, n);
+  const S21ConstMatrixView top = S21ConstMatrixView(noisy).Block(0, 0, n, 2);
+  EXPECT_TRUE(square.LeastSquares(top) == square.Solve(top));
+  const S21Matrix widened(S21FloatMatrix(a).LeastSquares(S21FloatMatrix(b)));
+  for (int j = 0; j < n; j++) {
+    EXPECT_NEAR(widened(j, 0), x(j, 0), 1e-3);
+    EXPECT_NEAR(widened(j, 1), x(j, 1), 1e-3);
+  }
+
+  S21Int64Matrix exact(3, 2), target(3, 1);
+  exact(0, 0) = exact(1, 1) = exact(2, 0) = exact(2, 1) = 1;
+  target(0, 0) = 2;
+  target(1, 0) = -1;
+  target(2, 0) = 1;
+  EXPECT_EQ(exact.LeastSquares(target)(0, 0), 2);
+  EXPECT_EQ(exact.LeastSquares(target)(1, 0), -1);
+
+  S21Matrix dependent(a);
+  for (int i = 0; i < m; i++) {
+    dependent(i, 3) = dependent(i, 1) - 2 * dependent(i, 2);
+  }
+  EXPECT_THROW(dependent.LeastSquares(b), std::length_error);
+  EXPECT_THROW(S21QR(dependent).LeastSquares(b), std::length_error);
+  EXPECT_THROW(a.Transpose().LeastSquares(S21Matrix(n, 1)),
+               std::length_error);
+  EXPECT_THROW(a.LeastSquares(S21Matrix(m - 1, 1)), std::length_error);
+}
+
+// Checks A * V = V * diag(w), V^T * V = I and ascending w.
+void ExpectEigenpairs(const S21Matrix& a, const S21Eigen& eigen,
+                      double tolerance) {
+  const int n = a.AccessRows();
+  const std::vector<double>& w = eigen.Values();
+  const S21Matrix& v = eigen.Vectors();
+  const S21Matrix av = a * v;
+  const S21Matrix gram = v.Transpose() * v;
+  for (int j = 0; j < n; j++) {
+    if (j > 0) {
+      EXPECT_LE(w[j - 1], w[j]);
+    }
+    for (int i = 0; i < n; i++) {
+      EXPECT_NEAR(av(i, j), v(i, j) * w[j], tolerance);
+      EXPECT_NEAR(gram(i, j), i == j ? 1 : 0, 1e-12);
+    }
+  }
+}
+
+TEST(Factorization, symmetricEigen) {
+  // 260 columns make several tridiagonalization panels, a split symmetric
+  // product and three merge levels.
+  const int threads = S21ThreadCount();
+  const int n = 260;
+  S21Matrix a(PseudoRandomInt64(n, n, 50));
+  a += a.Transpose();
+  S21SetThreadCount(1);
+  const S21Eigen eigen(a);
+  S21SetThreadCount(4);
+  const S21Eigen parallel(a);
+  S21SetThreadCount(threads);
+  ExpectEigenpairs(a, eigen, 1e-9);
+  ExpectEigenpairs(a, parallel, 1e-9);
+  const S21Eigen values(a, false);
+  for (int j = 0; j < n; j++) {
+    EXPECT_NEAR(values.Values()[j], eigen.Values()[j], 1e-9);
+    EXPECT_NEAR(parallel.Values()[j], eigen.Values()[j], 1e-9);
+  }
+  EXPECT_THROW(values.Vectors(), std::length_error);
+
+  // 65 and 129 rows split into leaves one row over a power of two.
+  for (int odd : {65, 129}) {
+    S21Matrix b(S21ConstMatrixView(a).Block(0, 0, odd, odd));
+    ExpectEigenpairs(b, S21Eigen(b), 1e-9);
+  }
+
+  // Only the lower triangle is read.
+  S21Matrix lower(a);
+  for (int i = 0; i < n; i++) {
+    for (int j = i + 1; j < n; j++) {
+      lower(i, j) = 0;
+    }
+  }
+  EXPECT_NEAR(S21Eigen(lower, false).Values()[n - 1], eigen.Values()[n - 1],
+              1e-9);
+
+  // 3 * I + u * u^T has the eigenvalue 3 m - 1 times over, so almost
+  // everything deflates.
+  const int m = 100;
+  S21Matrix rank_one(m, m);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < m; j++) {
+      rank_one(i, j) = (i == j ? 3 : 0) + (i % 7 - 3) * (j % 7 - 3) / 9.0;
+    }
+  }
+  const S21Eigen deflated(rank_one);
+  ExpectEigenpairs(rank_one, deflated, 1e-10);
+  EXPECT_NEAR(deflated.Values()[0], 3, 1e-10);
+  EXPECT_NEAR(deflated.Values()[m - 2], 3, 1e-10);
+
+  S21Matrix diagonal(m, m);
+  for (int i = 0; i < m; i++) {
+    diagonal(i, i) = (i * 37) % m - 50;
+  }
+  const S21Eigen sorted(diagonal);
+  ExpectEigenpairs(diagonal, sorted, 1e-12);
+  EXPECT_EQ(sorted.Values()[0], -50);
+  EXPECT_EQ(sorted.Values()[m - 1], 49);
+
+  S21Matrix small(2, 2);
+  small(0, 0) = small(1, 1) = 2;
+  small(0, 1) = small(1, 0) = 1;
+  const S21Eigen pair(small);
+  EXPECT_NEAR(pair.Values()[0], 1, 1e-15);
+  EXPECT_NEAR(pair.Values()[1], 3, 1e-15);
+  ExpectEigenpairs(small, pair, 1e-15);
+  EXPECT_EQ(S21Eigen(S21Matrix(1, 1)).Values()[0], 0);
+  EXPECT_EQ(S21Eigen(S21Matrix(1, 1)).Vectors()(0, 0), 1);
+  EXPECT_THROW(S21Eigen(S21Matrix(2, 3)), std::length_error);
+}
+
 int main(int argc, char *argv[]) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
-}
\ No newline at end of file
+}
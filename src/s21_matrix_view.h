@@ -0,0 +1,358 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_MATRIX_VIEW_H_
+#define CPP_S21_MATRIXPLUS_SRC_S21_MATRIX_VIEW_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_matrix_oop.h"
+#include "s21_transpose.h"
+
+// Non-owning window onto matrix elements: element (i, j) lives at
+// data[i * row_stride + j * col_stride]. A view can also skip one row and
+// one column of the area it spans, which is how minors are formed. Views
+// never own or copy their elements, so they must not outlive the storage
+// they refer to, and any reallocation of that storage invalidates them.
+//
+// Views are expression leaves: they combine with matrices and expressions
+// through +, - and scalar *, and an explicit S21Matrix(view) copies the
+// elements out. S21MatrixView also writes through to the elements, while
+// S21ConstMatrixView only reads them; both refer to doubles, and views of
+// other matrices are S21BasicMatrixView<T> or <const T>. Every matrix
+// routine that takes another matrix accepts either kind of view as well.
+template <typename T>
+class S21BasicMatrixView : public S21MatrixExpr<S21BasicMatrixView<T>> {
+  using Matrix = S21BasicMatrix<std::remove_const_t<T>>;
+  using MatrixRef =
+      std::conditional_t<std::is_const<T>::value, const Matrix&, Matrix&>;
+
+ public:
+  using Scalar = std::remove_const_t<T>;
+
+  S21BasicMatrixView(T* data, int rows, int cols, std::ptrdiff_t row_stride,
+                     std::ptrdiff_t col_stride) noexcept
+      : data_(data),
+        rows_(rows),
+        cols_(cols),
+        row_stride_(row_stride),
+        col_stride_(col_stride) {}
+  // The whole of matrix, which is empty if the matrix is. A writable view
+  // first gives the matrix a buffer of its own if it shares one with copies,
+  // and later copies of the matrix no longer share it.
+  S21BasicMatrixView(MatrixRef matrix) noexcept
+      : S21BasicMatrixView(nullptr, matrix.rows_, matrix.cols_, 0, 1) {
+    if constexpr (!std::is_const<T>::value) {
+      matrix.Pin();
+    }
+    data_ = matrix.matrix_;
+    row_stride_ = matrix.stride_;
+  }
+  // A writable view converts to a read-only one.
+  template <typename U, typename = std::enable_if_t<
+                            std::is_same<const U, T>::value &&
+                            !std::is_same<U, T>::value>>
+  S21BasicMatrixView(const S21BasicMatrixView<U>& other) noexcept
+      : data_(other.data_),
+        rows_(other.rows_),
+        cols_(other.cols_),
+        row_stride_(other.row_stride_),
+        col_stride_(other.col_stride_),
+        skip_row_(other.skip_row_),
+        skip_col_(other.skip_col_) {}
+  S21BasicMatrixView(const S21BasicMatrixView& other) noexcept = default;
+
+  // Assignments write the elements the view refers to instead of rebinding
+  // it. The source may read the destination only at the same positions.
+  S21BasicMatrixView& operator=(const S21BasicMatrixView& other) {
+    Assign(other);
+    return *this;
+  }
+  template <typename E>
+  S21BasicMatrixView& operator=(const S21MatrixExpr<E>& expr) {
+    Assign(expr.Self());
+    return *this;
+  }
+  S21BasicMatrixView& operator=(const Matrix& other) {
+    Assign(S21MatrixTerm<Scalar>(other));
+    return *this;
+  }
+  template <typename E, typename = S21EnableIfOperand<E>>
+  S21BasicMatrixView& operator+=(const E& other) {
+    Assign(*this + other);
+    return *this;
+  }
+  template <typename E, typename = S21EnableIfOperand<E>>
+  S21BasicMatrixView& operator-=(const E& other) {
+    Assign(*this - other);
+    return *this;
+  }
+  S21BasicMatrixView& operator*=(const Scalar other) {
+    Assign(*this * other);
+    return *this;
+  }
+
+  T& operator()(int i, int j) const {
+    if (rows_ <= i || cols_ <= j || i < 0 || j < 0) {
+      throw std::length_error(
+          "index is outside the matrix or no matrix exists");
+    }
+    return At(i, j);
+  }
+
+  int Rows() const noexcept { return rows_; }
+  int Cols() const noexcept { return cols_; }
+
+  // rows x cols block whose top left corner is element (row, col).
+  S21BasicMatrixView Block(int row, int col, int rows, int cols) const {
+    if (row < 0 || col < 0 || rows < 0 || cols < 0 || row + rows > rows_ ||
+        col + cols > cols_) {
+      throw std::length_error("the block is outside the matrix");
+    }
+    S21BasicMatrixView result(*this);
+    result.rows_ = rows;
+    result.cols_ = cols;
+    result.data_ = data_ + Offset(row, skip_row_, row_stride_, rows,
+                                  &result.skip_row_) +
+                   Offset(col, skip_col_, col_stride_, cols,
+                          &result.skip_col_);
+    return result;
+  }
+  S21BasicMatrixView RowView(int i) const { return Block(i, 0, 1, cols_); }
+  S21BasicMatrixView ColView(int j) const { return Block(0, j, rows_, 1); }
+  // Everything but row i and column j. Views that already skip a row or a
+  // column cannot skip another one.
+  S21BasicMatrixView Minor(int i, int j) const {
+    if (rows_ <= i || cols_ <= j || i < 0 || j < 0) {
+      throw std::length_error(
+          "index is outside the matrix or no matrix exists");
+    }
+    if (skip_row_ != kNoSkip || skip_col_ != kNoSkip) {
+      throw std::length_error("the view already skips a row or a column");
+    }
+    S21BasicMatrixView result(*this);
+    result.rows_ = rows_ - 1;
+    result.cols_ = cols_ - 1;
+    result.skip_row_ = i < result.rows_ ? i : kNoSkip;
+    result.skip_col_ = j < result.cols_ ? j : kNoSkip;
+    return result;
+  }
+
+  // Writes the elements row-major to out, whose rows are ld apart. The
+  // transpose of a dense block is copied in cache-sized tiles.
+  void CopyTo(Scalar* out, std::ptrdiff_t ld) const noexcept {
+    if (row_stride_ == 1 && col_stride_ != 1 && skip_row_ == kNoSkip &&
+        skip_col_ == kNoSkip) {
+      S21Transpose(cols_, rows_, data_, col_stride_, out, ld);
+    } else {
+      for (int i = 0; i < rows_; ++i) {
+        const T* row = RowPtr(i);
+        Scalar* out_row = out + i * ld;
+        if (HasDenseRows()) {
+          std::copy(row, row + cols_, out_row);
+        } else {
+          for (int j = 0; j < cols_; ++j) {
+            out_row[j] = row[ColOffset(j)];
+          }
+        }
+      }
+    }
+  }
+
+  bool EqMatrix(const S21BasicMatrixView<const Scalar>& other) const noexcept {
+    bool equal = rows_ == other.rows_ && cols_ == other.cols_ && rows_ > 0;
+    for (int i = 0; i < rows_ && equal; ++i) {
+      for (int j = 0; j < cols_ && equal; ++j) {
+        if constexpr (std::is_integral<Scalar>::value) {
+          equal = At(i, j) == other.At(i, j);
+        } else {
+          equal = std::fabs(At(i, j) - other.At(i, j)) < S21Tolerance<Scalar>();
+        }
+      }
+    }
+    return equal;
+  }
+
+  // The same elements with rows and columns swapped, in O(1).
+  S21BasicMatrixView Transpose() const {
+    if (rows_ == 0) {
+      throw std::length_error("no matrix exists");
+    }
+    S21BasicMatrixView result(*this);
+    std::swap(result.rows_, result.cols_);
+    std::swap(result.row_stride_, result.col_stride_);
+    std::swap(result.skip_row_, result.skip_col_);
+    return result;
+  }
+
+  Matrix CalcComplements() const {
+    CheckSquare();
+    return Matrix::CalcCompHelper(*this);
+  }
+
+  Scalar Determinant(S21Structure structure = S21Structure::kGeneral) const {
+    CheckSquare();
+    return Matrix::DetermOf(*this, structure);
+  }
+
+  Matrix InverseMatrix(S21Structure structure = S21Structure::kGeneral) const {
+    CheckSquare();
+    return Matrix::InverseOf(*this, structure);
+  }
+
+  Matrix Solve(const S21BasicMatrixView<const Scalar>& b,
+               S21Precision precision = S21Precision::kFull) const {
+    CheckSquare();
+    return Matrix::SolveOf(*this, b, precision, S21Structure::kGeneral);
+  }
+
+  Matrix Solve(const S21BasicMatrixView<const Scalar>& b,
+               S21Structure structure) const {
+    CheckSquare();
+    return Matrix::SolveOf(*this, b, S21Precision::kFull, structure);
+  }
+
+  Matrix LeastSquares(const S21BasicMatrixView<const Scalar>& b) const {
+    return Matrix::LeastSquaresOf(*this, b);
+  }
+
+  // Expression leaf interface.
+  struct Reader {
+    const T* row;
+    std::ptrdiff_t col_stride;
+    int skip_col;
+    Scalar operator[](int j) const noexcept {
+      return row[(j + (j >= skip_col)) * col_stride];
+    }
+  };
+  Reader RowReader(int i) const noexcept {
+    return {RowPtr(i), col_stride_, skip_col_};
+  }
+  bool ReadsOutside(const S21BasicMatrixView<const Scalar>& target) const
+      noexcept {
+    const bool same_layout =
+        data_ == target.data_ && rows_ == target.rows_ &&
+        cols_ == target.cols_ && row_stride_ == target.row_stride_ &&
+        col_stride_ == target.col_stride_ && skip_row_ == target.skip_row_ &&
+        skip_col_ == target.skip_col_;
+    return rows_ > 0 && cols_ > 0 && target.rows_ > 0 && target.cols_ > 0 &&
+           !same_layout && &At(0, 0) <= &target.At(target.rows_ - 1,
+                                                   target.cols_ - 1) &&
+           &target.At(0, 0) <= &At(rows_ - 1, cols_ - 1);
+  }
+
+ private:
+  template <typename>
+  friend class S21BasicMatrixView;
+  template <typename>
+  friend class S21BasicMatrix;
+
+  static constexpr int kNoSkip = std::numeric_limits<int>::max();
+
+  T* data_;
+  int rows_, cols_;
+  std::ptrdiff_t row_stride_, col_stride_;
+  int skip_row_{kNoSkip}, skip_col_{kNoSkip};
+
+  // Offset of the index-th row or column and the skip of a count-long range
+  // starting there.
+  static std::ptrdiff_t Offset(int index, int skip, std::ptrdiff_t stride,
+                               int count, int* new_skip) noexcept {
+    std::ptrdiff_t offset = index * stride;
+    *new_skip = kNoSkip;
+    if (index >= skip) {
+      offset += stride;
+    } else if (skip - index < count) {
+      *new_skip = skip - index;
+    }
+    return offset;
+  }
+
+  T* RowPtr(int i) const noexcept {
+    return data_ + (i + (i >= skip_row_)) * row_stride_;
+  }
+  std::ptrdiff_t ColOffset(int j) const noexcept {
+    return (j + (j >= skip_col_)) * col_stride_;
+  }
+  T& At(int i, int j) const noexcept { return RowPtr(i)[ColOffset(j)]; }
+  // Whether every row is a plain run of cols_ elements.
+  bool HasDenseRows() const noexcept {
+    return col_stride_ == 1 && skip_col_ == kNoSkip;
+  }
+  // Whether the view is one run of rows_ * cols_ elements.
+  bool IsContiguous() const noexcept {
+    return HasDenseRows() && skip_row_ == kNoSkip && row_stride_ == cols_;
+  }
+
+  void CheckSquare() const {
+    if (rows_ != cols_ || rows_ == 0) {
+      throw std::length_error("the matrix is not square or no matrix exists");
+    }
+  }
+
+  template <typename E>
+  void Assign(const E& expr) {
+    static_assert(!std::is_const<T>::value, "the view is read-only");
+    if (expr.Rows() != rows_ || expr.Cols() != cols_) {
+      throw std::length_error("different matrix dimensions");
+    }
+    if (expr.ReadsOutside(*this)) {
+      const Matrix copy(expr);
+      Assign(S21MatrixTerm<Scalar>(copy));
+    } else {
+      AssignInPlace(expr);
+    }
+  }
+
+  template <typename E>
+  void AssignInPlace(const E& expr) noexcept {
+    for (int i = 0; i < rows_; ++i) {
+      const auto reader = expr.RowReader(i);
+      T* row = RowPtr(i);
+      for (int j = 0; j < cols_; ++j) {
+        row[ColOffset(j)] = reader[j];
+      }
+    }
+  }
+};
+
+using S21MatrixView = S21BasicMatrixView<double>;
+
+template <typename T>
+bool S21MatrixTerm<T>::ReadsOutside(
+    const S21BasicMatrixView<const T>& target) const noexcept {
+  return S21BasicMatrixView<const T>(matrix_).ReadsOutside(target);
+}
+
+// Comparisons read views in place.
+template <typename T>
+const S21BasicMatrixView<T>& S21Evaluate(
+    const S21BasicMatrixView<T>& view) noexcept {
+  return view;
+}
+
+template <typename T>
+struct S21IsMatrixOrView : std::false_type {};
+template <typename T>
+struct S21IsMatrixOrView<S21BasicMatrix<T>> : std::true_type {};
+template <typename T>
+struct S21IsMatrixOrView<S21BasicMatrixView<T>> : std::true_type {};
+
+// Products of matrices and views of one element type go through the
+// read-only view overload.
+template <typename L, typename R,
+          typename = std::enable_if_t<
+              S21IsMatrixOrView<L>::value && S21IsMatrixOrView<R>::value &&
+              std::is_same<typename L::Scalar, typename R::Scalar>::value &&
+              !(std::is_same<L, R>::value &&
+                std::is_same<L, S21BasicMatrixView<
+                                    const typename L::Scalar>>::value)>>
+S21BasicMatrix<typename L::Scalar> operator*(const L& lhs, const R& rhs) {
+  using ConstView = S21BasicMatrixView<const typename L::Scalar>;
+  return ConstView(lhs) * ConstView(rhs);
+}
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_MATRIX_VIEW_H_
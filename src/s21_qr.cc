@@ -0,0 +1,533 @@
+#include "s21_qr.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+#include "s21_arena.h"
+#include "s21_gemm.h"
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Width below which a panel is factored one reflector at a time.
+constexpr int kLeafColumns = 8;
+// Rows below which a pass over a panel runs inline, and the most pieces a
+// pass is split into. The split depends only on the number of rows, so
+// results do not change with the number of threads.
+constexpr int kRowGrain = 2048;
+constexpr int kMaxChunks = 64;
+// Elements of [A | B] in each piece of a tall least-squares problem, which
+// is then factored within the L2 cache.
+constexpr int kPieceElements = 1 << 16;
+
+// Euclidean norm of count elements stride apart.
+template <typename T>
+T Norm(int count, const T* x, long stride) {
+  T sum = 0;
+  for (int i = 0; i < count; ++i) {
+    sum += x[i * stride] * x[i * stride];
+  }
+  return std::sqrt(sum);
+}
+
+// Splits [0, rows) into contiguous pieces, lets fn(begin, end, partial)
+// accumulate each piece into its own zeroed width-long partial on the pool
+// and stores the sum of the partials in sum.
+template <typename T, typename Fn>
+void ReduceRows(int rows, int width, T* sum, const Fn& fn) {
+  const int chunks = std::max(1, std::min(kMaxChunks, rows / kRowGrain));
+  S21ArenaScope scratch;
+  T* partials = scratch.Allocate<T>(static_cast<long>(chunks) * width);
+  std::fill(partials, partials + static_cast<long>(chunks) * width, T{0});
+  S21ParallelFor(0, chunks, 1, [&](int begin, int end) {
+    for (int c = begin; c < end; ++c) {
+      fn(static_cast<int>(static_cast<long>(rows) * c / chunks),
+         static_cast<int>(static_cast<long>(rows) * (c + 1) / chunks),
+         partials + static_cast<long>(c) * width);
+    }
+  });
+  const S21BasicKernels<T>& kernels = S21ActiveKernels<T>();
+  std::copy(partials, partials + width, sum);
+  for (int c = 1; c < chunks; ++c) {
+    kernels.axpy(width, 1, partials + static_cast<long>(c) * width, sum);
+  }
+}
+
+// Copies the top nb x nb block of the reflectors stored below the diagonal
+// at v into out as the unit lower triangle it stands for.
+template <typename T>
+void UnitLower(int nb, const T* v, int ldv, T* out) {
+  for (int i = 0; i < nb; ++i) {
+    const T* v_i = v + static_cast<std::ptrdiff_t>(i) * ldv;
+    std::copy(v_i, v_i + i, out + i * nb);
+    out[i * nb + i] = 1;
+    std::fill(out + i * nb + i + 1, out + (i + 1) * nb, T{0});
+  }
+}
+
+// Upper triangular nb x nb t with H(0) * ... * H(nb - 1) = I - V * T * V^T
+// for the nb reflectors stored below the diagonal of the rows x nb matrix
+// at v. Column i of T is -tau_i * T * V^T * v_i over the columns before it,
+// so all it needs from V is the Gram matrix V^T * V.
+template <typename T>
+void BuildT(int rows, int nb, const T* v, int ldv, const T* tau, T* t) {
+  S21ArenaScope scratch;
+  T* v1 = scratch.Allocate<T>(nb * nb);
+  T* gram = scratch.Allocate<T>(nb * nb);
+  const T* v2 = v + static_cast<std::ptrdiff_t>(nb) * ldv;
+  ReduceRows(rows - nb, nb * nb, gram, [&](int begin, int end, T* partial) {
+    const T* v2_begin = v2 + static_cast<std::ptrdiff_t>(begin) * ldv;
+    S21Gemm(true, false, nb, nb, end - begin, T{1}, v2_begin, ldv, v2_begin,
+            ldv, partial, nb);
+  });
+  UnitLower(nb, v, ldv, v1);
+  S21Gemm(true, false, nb, nb, nb, T{1}, v1, nb, v1, nb, gram, nb);
+  std::fill(t, t + nb * nb, T{0});
+  for (int i = 0; i < nb; ++i) {
+    t[i * nb + i] = tau[i];
+    for (int j = 0; j < i; ++j) {
+      T sum = 0;
+      for (int l = j; l < i; ++l) {
+        sum += t[j * nb + l] * gram[l * nb + i];
+      }
+      t[j * nb + i] = -tau[i] * sum;
+    }
+  }
+}
+
+// Overwrites the rows x cols matrix at c with (I - V * T * V^T) * c, or
+// with its transpose times c if transpose is set, for V and T as in
+// BuildT(). The product V^T * C runs down all the rows and is split into
+// pieces by ReduceRows(); the update of C is one GEMM, which splits itself.
+template <typename T>
+void ApplyBlock(int rows, int nb, int cols, const T* v, int ldv, const T* t,
+                bool transpose, T* c, int ldc) {
+  S21ArenaScope scratch;
+  T* v1 = scratch.Allocate<T>(nb * nb);
+  T* w = scratch.Allocate<T>(static_cast<long>(nb) * cols);
+  T* tw = scratch.Allocate<T>(static_cast<long>(nb) * cols);
+  const T* v2 = v + static_cast<std::ptrdiff_t>(nb) * ldv;
+  T* c2 = c + static_cast<std::ptrdiff_t>(nb) * ldc;
+  ReduceRows(rows - nb, nb * cols, w, [&](int begin, int end, T* partial) {
+    S21Gemm(true, false, nb, cols, end - begin, T{1},
+            v2 + static_cast<std::ptrdiff_t>(begin) * ldv, ldv,
+            c2 + static_cast<std::ptrdiff_t>(begin) * ldc, ldc, partial, cols);
+  });
+  UnitLower(nb, v, ldv, v1);
+  S21Gemm(true, false, nb, cols, nb, T{1}, v1, nb, c, ldc, w, cols);
+  std::fill(tw, tw + static_cast<long>(nb) * cols, T{0});
+  S21Gemm(transpose, false, nb, cols, nb, T{1}, t, nb, w, cols, tw, cols);
+  S21Gemm(false, false, nb, cols, nb, T{-1}, v1, nb, tw, cols, c, ldc);
+  S21Gemm(false, false, rows - nb, cols, nb, T{-1}, v2, ldv, tw, cols, c2,
+          ldc);
+}
+
+// Unpivoted Householder QR of the rows x cols panel at p, cols <= rows,
+// reflector by reflector. Each step makes one pass down the rows to get
+// the norm of the column together with its products with the columns to
+// its right, and one more to scale the reflector and update those columns;
+// both passes are split by rows.
+template <typename T>
+void FactorColumns(int rows, int cols, T* p, int ldp, T* tau) {
+  const S21BasicKernels<T>& kernels = S21ActiveKernels<T>();
+  const auto row = [p, ldp](int i) {
+    return p + static_cast<std::ptrdiff_t>(i) * ldp;
+  };
+  S21ArenaScope scratch;
+  T* g = scratch.Allocate<T>(cols);
+  T* w = scratch.Allocate<T>(cols);
+  for (int k = 0; k < cols; ++k) {
+    const int width = cols - k;
+    ReduceRows(rows - k - 1, width, g, [&](int begin, int end, T* partial) {
+      for (int i = k + 1 + begin; i < k + 1 + end; ++i) {
+        const T* row_i = row(i) + k;
+        for (int j = 0; j < width; ++j) {
+          partial[j] += row_i[0] * row_i[j];
+        }
+      }
+    });
+    const T alpha = row(k)[k];
+    const T tail = std::sqrt(g[0]);
+    tau[k] = 0;
+    if (tail != 0) {
+      const T beta = -std::copysign(std::hypot(alpha, tail), alpha);
+      const T scale = 1 / (alpha - beta);
+      const T tau_k = tau[k] = (beta - alpha) / beta;
+      for (int j = 1; j < width; ++j) {
+        w[j] = row(k)[k + j] + scale * g[j];
+      }
+      row(k)[k] = beta;
+      kernels.axpy(width - 1, -tau_k, w + 1, row(k) + k + 1);
+      S21ParallelFor(k + 1, rows, kRowGrain, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+          T* row_i = row(i) + k;
+          row_i[0] *= scale;
+          const T factor = tau_k * row_i[0];
+          for (int j = 1; j < width; ++j) {
+            row_i[j] -= factor * w[j];
+          }
+        }
+      });
+    }
+  }
+}
+
+// The same for any panel, recursively: the left half is factored, its
+// reflectors are applied to the right half as one block, and the right half
+// below them is factored in turn. Only the kLeafColumns-wide leaves are
+// left to FactorColumns(); the rest of the work goes through GEMM.
+template <typename T>
+void FactorPanel(int rows, int cols, T* p, int ldp, T* tau) {
+  if (cols <= kLeafColumns) {
+    FactorColumns(rows, cols, p, ldp, tau);
+  } else {
+    const int left = cols / 2;
+    S21ArenaScope scratch;
+    T* t = scratch.Allocate<T>(left * left);
+    FactorPanel(rows, left, p, ldp, tau);
+    BuildT(rows, left, p, ldp, tau, t);
+    ApplyBlock(rows, left, cols - left, p, ldp, t, true, p + left, ldp);
+    FactorPanel(rows - left, cols - left,
+                p + static_cast<std::ptrdiff_t>(left) * ldp + left, ldp,
+                tau + left);
+  }
+}
+
+}  // namespace
+
+S21QR::S21QR(const S21ConstMatrixView& other) : qr_(other) {
+  if (other.Rows() == 0) {
+    throw std::length_error("no matrix exists");
+  }
+  const int steps = std::min(qr_.rows_, qr_.cols_);
+  tau_.resize(steps);
+  columns_.resize(qr_.cols_);
+  sign_ = Factor(qr_.rows_, qr_.cols_, qr_.matrix_, qr_.stride_, tau_.data(),
+                 columns_.data());
+  const double threshold = std::max(qr_.rows_, qr_.cols_) *
+                           std::numeric_limits<double>::epsilon() *
+                           std::abs(qr_.At(0, 0));
+  while (rank_ < steps && std::abs(qr_.At(rank_, rank_)) > threshold) {
+    ++rank_;
+  }
+}
+
+int S21QR::Rank() const noexcept { return rank_; }
+
+double S21QR::Determinant() const {
+  CheckSquare();
+  double result = sign_;
+  for (int i = 0; i < qr_.rows_; ++i) {
+    result *= qr_.At(i, i);
+  }
+  return result;
+}
+
+double S21QR::LogAbsDeterminant() const {
+  CheckSquare();
+  double result = 0;
+  for (int i = 0; i < qr_.rows_; ++i) {
+    result += std::log(std::abs(qr_.At(i, i)));
+  }
+  return result;
+}
+
+S21Matrix S21QR::Solve(const S21ConstMatrixView& b) const {
+  CheckSquare();
+  if (b.Rows() != qr_.rows_ || b.Cols() == 0) {
+    throw std::length_error("different matrix dimensions or no matrix exists");
+  }
+  if (rank_ < qr_.cols_) {
+    throw std::length_error("matrix determinant is 0");
+  }
+  const int n = qr_.rows_;
+  S21Matrix z(b);
+  ApplyQt(n, n, z.cols_, qr_.matrix_, qr_.stride_, tau_.data(), z.matrix_,
+          z.stride_);
+  Substitute(n, z.cols_, qr_.matrix_, qr_.stride_, z.matrix_, z.stride_);
+  S21Matrix result(n, z.cols_);
+  for (int j = 0; j < n; ++j) {
+    std::copy(z.Row(j), z.Row(j) + z.cols_, result.Row(columns_[j]));
+  }
+  return result;
+}
+
+S21Matrix S21QR::Inverse() const {
+  std::call_once(inverse_once_, [this] {
+    CheckSquare();
+    S21Matrix identity(qr_.rows_, qr_.rows_);
+    for (int i = 0; i < qr_.rows_; ++i) {
+      identity.At(i, i) = 1;
+    }
+    inverse_ = Solve(identity);
+  });
+  return inverse_;
+}
+
+S21Matrix S21QR::LeastSquares(const S21ConstMatrixView& b) const {
+  const int m = qr_.rows_;
+  const int n = qr_.cols_;
+  if (b.Rows() != m || b.Cols() == 0) {
+    throw std::length_error("different matrix dimensions or no matrix exists");
+  }
+  if (rank_ < n) {
+    throw std::length_error("the columns of the matrix are linearly dependent");
+  }
+  S21Matrix z(b);
+  ApplyQt(m, n, z.cols_, qr_.matrix_, qr_.stride_, tau_.data(), z.matrix_,
+          z.stride_);
+  Substitute(n, z.cols_, qr_.matrix_, qr_.stride_, z.matrix_, z.stride_);
+  S21Matrix result(n, z.cols_);
+  for (int j = 0; j < n; ++j) {
+    std::copy(z.Row(j), z.Row(j) + z.cols_, result.Row(columns_[j]));
+  }
+  return result;
+}
+
+void S21QR::CheckSquare() const {
+  if (qr_.rows_ != qr_.cols_) {
+    throw std::length_error("the matrix is not square or no matrix exists");
+  }
+}
+
+// Step k swaps the column of largest remaining norm into place, reflects
+// it onto a multiple of e_k with H = I - tau * v * v^T, v(k) = 1, and
+// applies H to the columns to its right as rank-1 row updates. The
+// remaining norms are downdated from row k instead of being recomputed,
+// except where cancellation has eaten most of their accuracy.
+template <typename T>
+int S21QR::Factor(int m, int n, T* a, int lda, T* tau, int* columns) {
+  const S21BasicKernels<T>& kernels = S21ActiveKernels<T>();
+  const T recompute = std::sqrt(std::numeric_limits<T>::epsilon());
+  const auto row = [a, lda](int i) {
+    return a + static_cast<std::ptrdiff_t>(i) * lda;
+  };
+  S21ArenaScope scratch;
+  T* norms = scratch.Allocate<T>(n);
+  T* exact_norms = scratch.Allocate<T>(n);
+  T* w = scratch.Allocate<T>(n);
+  for (int j = 0; j < n; ++j) {
+    norms[j] = exact_norms[j] = Norm(m, a + j, lda);
+  }
+  std::iota(columns, columns + n, 0);
+  int sign = 1;
+  for (int k = 0; k < std::min(m, n); ++k) {
+    // Norm of column j below row k.
+    const auto tail_norm = [&](int j) {
+      return k + 1 < m ? Norm(m - k - 1, row(k + 1) + j, lda) : T{0};
+    };
+    const int pivot =
+        static_cast<int>(std::max_element(norms + k, norms + n) - norms);
+    if (pivot != k) {
+      for (int i = 0; i < m; ++i) {
+        std::swap(row(i)[k], row(i)[pivot]);
+      }
+      std::swap(norms[k], norms[pivot]);
+      std::swap(exact_norms[k], exact_norms[pivot]);
+      std::swap(columns[k], columns[pivot]);
+      sign = -sign;
+    }
+    const T alpha = row(k)[k];
+    const T tail = tail_norm(k);
+    tau[k] = 0;
+    if (tail != 0) {
+      const T beta = -std::copysign(std::hypot(alpha, tail), alpha);
+      tau[k] = (beta - alpha) / beta;
+      for (int i = k + 1; i < m; ++i) {
+        row(i)[k] /= alpha - beta;
+      }
+      row(k)[k] = beta;
+      sign = -sign;
+      const int cols = n - k - 1;
+      std::copy(row(k) + k + 1, row(k) + n, w);
+      for (int i = k + 1; i < m; ++i) {
+        kernels.axpy(cols, row(i)[k], row(i) + k + 1, w);
+      }
+      kernels.axpy(cols, -tau[k], w, row(k) + k + 1);
+      for (int i = k + 1; i < m; ++i) {
+        kernels.axpy(cols, -tau[k] * row(i)[k], w, row(i) + k + 1);
+      }
+    }
+    for (int j = k + 1; j < n; ++j) {
+      if (norms[j] != 0) {
+        const T ratio = std::abs(row(k)[j]) / norms[j];
+        const T left = std::max(T{0}, (1 - ratio) * (1 + ratio));
+        if (left * (norms[j] / exact_norms[j]) * (norms[j] / exact_norms[j]) <=
+            recompute) {
+          norms[j] = exact_norms[j] = tail_norm(j);
+        } else {
+          norms[j] *= std::sqrt(left);
+        }
+      }
+    }
+  }
+  return sign;
+}
+
+// Right-looking in blocks of kBlock columns: each panel is factored by
+// FactorPanel() and, while columns remain to its right, its reflectors are
+// gathered into I - V * T * V^T and applied to all of them at once.
+template <typename T>
+void S21QR::Factor(int m, int n, T* a, int lda, T* tau) {
+  const int steps = std::min(m, n);
+  S21ArenaScope scratch;
+  T* t = scratch.Allocate<T>(kBlock * kBlock);
+  for (int k0 = 0; k0 < steps; k0 += kBlock) {
+    const int nb = std::min(kBlock, steps - k0);
+    T* panel = a + static_cast<std::ptrdiff_t>(k0) * lda + k0;
+    FactorPanel(m - k0, nb, panel, lda, tau + k0);
+    if (k0 + nb < n) {
+      BuildT(m - k0, nb, panel, lda, tau + k0, t);
+      ApplyBlock(m - k0, nb, n - k0 - nb, panel, lda, t, true, panel + nb,
+                 lda);
+    }
+  }
+}
+
+// Q^T = H(min(m, n) - 1) * ... * H(0), applied kBlock reflectors at a time.
+template <typename T>
+void S21QR::ApplyQt(int m, int n, int nrhs, const T* qr, int ldqr,
+                    const T* tau, T* b, int ldb) {
+  const int steps = std::min(m, n);
+  S21ArenaScope scratch;
+  T* t = scratch.Allocate<T>(kBlock * kBlock);
+  for (int k0 = 0; k0 < steps; k0 += kBlock) {
+    const int nb = std::min(kBlock, steps - k0);
+    const T* panel = qr + static_cast<std::ptrdiff_t>(k0) * ldqr + k0;
+    BuildT(m - k0, nb, panel, ldqr, tau + k0, t);
+    ApplyBlock(m - k0, nb, nrhs, panel, ldqr, t, true,
+               b + static_cast<std::ptrdiff_t>(k0) * ldb, ldb);
+  }
+}
+
+// Q = H(0) * ... * H(min(m, n) - 1), applied kBlock reflectors at a time
+// starting from the last block.
+template <typename T>
+void S21QR::ApplyQ(int m, int n, int nrhs, const T* qr, int ldqr,
+                   const T* tau, T* b, int ldb) {
+  const int steps = std::min(m, n);
+  S21ArenaScope scratch;
+  T* t = scratch.Allocate<T>(kBlock * kBlock);
+  for (int block = (steps + kBlock - 1) / kBlock - 1; block >= 0; --block) {
+    const int k0 = block * kBlock;
+    const int nb = std::min(kBlock, steps - k0);
+    const T* panel = qr + static_cast<std::ptrdiff_t>(k0) * ldqr + k0;
+    BuildT(m - k0, nb, panel, ldqr, tau + k0, t);
+    ApplyBlock(m - k0, nb, nrhs, panel, ldqr, t, false,
+               b + static_cast<std::ptrdiff_t>(k0) * ldb, ldb);
+  }
+}
+
+template <typename T>
+void S21QR::Substitute(int n, int nrhs, const T* r, int ldr, T* b, int ldb) {
+  const S21BasicKernels<T>& kernels = S21ActiveKernels<T>();
+  for (int i = n - 1; i >= 0; --i) {
+    const T* r_i = r + static_cast<std::ptrdiff_t>(i) * ldr;
+    T* b_i = b + static_cast<std::ptrdiff_t>(i) * ldb;
+    for (int k = i + 1; k < n; ++k) {
+      kernels.axpy(nrhs, -r_i[k], b + static_cast<std::ptrdiff_t>(k) * ldb,
+                   b_i);
+    }
+    kernels.scale(nrhs, 1 / r_i[i], b_i);
+  }
+}
+
+// Tall-skinny QR as a reduction tree. [A | B] is cut into pieces of at
+// least 2n rows, which are factored independently on the pool; each leaves
+// n rows of [R | Q^T * B], and stacking those gives a problem with the same
+// solution and at most half the rows, reduced the same way until one piece
+// remains. Every piece is read once and factored in cache, where a single
+// factorization of a tall A would stream it once per column.
+template <typename T>
+bool S21QR::LeastSquares(const S21BasicMatrixView<const T>& a,
+                         const S21BasicMatrixView<const T>& b, T* x,
+                         int ldx) {
+  using View = S21BasicMatrixView<const T>;
+  const int n = a.Cols();
+  const int nrhs = b.Cols();
+  const int width = n + nrhs;
+  const int piece_rows = std::max(2 * n, kPieceElements / width);
+  S21ArenaScope scratch;
+  int pieces = 0;
+  // Reduces one level and returns the stacked rows it leaves.
+  const auto reduce = [&](const View& top_a, const View& top_b) {
+    const int rows = top_a.Rows();
+    pieces = std::max(1, rows / piece_rows);
+    T* stacked = scratch.Allocate<T>(static_cast<long>(pieces) * n * width);
+    S21ParallelFor(0, pieces, 1, [&](int begin, int end) {
+      S21ArenaScope piece_scratch;
+      T* tau = piece_scratch.Allocate<T>(n);
+      T* piece = piece_scratch.Allocate<T>(
+          static_cast<long>(rows / pieces + 1) * width);
+      for (int p = begin; p < end; ++p) {
+        const int first =
+            static_cast<int>(static_cast<long>(rows) * p / pieces);
+        const int count =
+            static_cast<int>(static_cast<long>(rows) * (p + 1) / pieces) -
+            first;
+        top_a.Block(first, 0, count, n).CopyTo(piece, width);
+        top_b.Block(first, 0, count, nrhs).CopyTo(piece + n, width);
+        Factor(count, n, piece, width, tau);
+        ApplyQt(count, n, nrhs, piece, width, tau, piece + n, width);
+        T* out = stacked + static_cast<long>(p) * n * width;
+        for (int i = 0; i < n; ++i) {
+          std::fill(out + i * width, out + i * width + i, T{0});
+          std::copy(piece + i * width + i, piece + (i + 1) * width,
+                    out + i * width + i);
+        }
+      }
+    });
+    return stacked;
+  };
+  T* stacked = reduce(a, b);
+  while (pieces > 1) {
+    stacked = reduce(View(stacked, pieces * n, n, width, 1),
+                     View(stacked + n, pieces * n, nrhs, width, 1));
+  }
+  T largest = 0;
+  for (int i = 0; i < n; ++i) {
+    largest = std::max(largest, std::abs(stacked[i * width + i]));
+  }
+  const T threshold = a.Rows() * std::numeric_limits<T>::epsilon() * largest;
+  bool full_rank = true;
+  for (int i = 0; i < n; ++i) {
+    full_rank = full_rank && std::abs(stacked[i * width + i]) > threshold;
+  }
+  if (full_rank) {
+    for (int i = 0; i < n; ++i) {
+      std::copy(stacked + i * width + n, stacked + (i + 1) * width,
+                x + static_cast<std::ptrdiff_t>(i) * ldx);
+    }
+    Substitute(n, nrhs, stacked, width, x, ldx);
+  }
+  return full_rank;
+}
+
+template int S21QR::Factor(int m, int n, double* a, int lda, double* tau,
+                           int* columns);
+template int S21QR::Factor(int m, int n, float* a, int lda, float* tau,
+                           int* columns);
+template void S21QR::ApplyQt(int m, int n, int nrhs, const double* qr,
+                             int ldqr, const double* tau, double* b, int ldb);
+template void S21QR::ApplyQt(int m, int n, int nrhs, const float* qr,
+                             int ldqr, const float* tau, float* b, int ldb);
+template void S21QR::Factor(int m, int n, double* a, int lda, double* tau);
+template void S21QR::Factor(int m, int n, float* a, int lda, float* tau);
+template void S21QR::ApplyQ(int m, int n, int nrhs, const double* qr,
+                            int ldqr, const double* tau, double* b, int ldb);
+template void S21QR::ApplyQ(int m, int n, int nrhs, const float* qr,
+                            int ldqr, const float* tau, float* b, int ldb);
+template void S21QR::Substitute(int n, int nrhs, const double* r, int ldr,
+                                double* b, int ldb);
+template void S21QR::Substitute(int n, int nrhs, const float* r, int ldr,
+                                float* b, int ldb);
+template bool S21QR::LeastSquares(const S21BasicMatrixView<const double>& a,
+                                  const S21BasicMatrixView<const double>& b,
+                                  double* x, int ldx);
+template bool S21QR::LeastSquares(const S21BasicMatrixView<const float>& a,
+                                  const S21BasicMatrixView<const float>& b,
+                                  float* x, int ldx);
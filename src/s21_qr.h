@@ -0,0 +1,91 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_QR_H_
+#define CPP_S21_MATRIXPLUS_SRC_S21_QR_H_
+
+#include <mutex>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Householder QR factorization with column pivoting: A * P = Q * R for an
+// m x n matrix A, where Q is orthogonal, R is upper trapezoidal and P moves
+// the column of largest remaining norm forward at every step, so the
+// diagonal of R does not grow in magnitude and reveals the rank. R and the
+// Householder vectors that make up Q are packed in one m x n matrix. Like
+// S21LU, one object answers any number of queries about the same matrix,
+// and it also handles rank-deficient and rectangular ones.
+//
+// The static routines also serve S21Matrix::LeastSquares(), which factors
+// without pivoting so that the reflectors can be applied kBlock at a time
+// through GEMM.
+class S21QR {
+ public:
+  explicit S21QR(const S21ConstMatrixView& other);
+  S21QR(const S21QR&) = delete;
+  S21QR& operator=(const S21QR&) = delete;
+
+  // Number of diagonal elements of R larger in magnitude than
+  // max(m, n) * epsilon * |R(0, 0)|.
+  int Rank() const noexcept;
+  // The rest need a square matrix and throw otherwise.
+  double Determinant() const;
+  // ln |det A|; -inf if A is singular.
+  double LogAbsDeterminant() const;
+  // Solution x of A * x = b for every column of b. Throws like
+  // S21Matrix::InverseMatrix() when Rank() is less than n.
+  S21Matrix Solve(const S21ConstMatrixView& b) const;
+  // The inverse is computed by the first call and shared with the
+  // matrices later calls return.
+  S21Matrix Inverse() const;
+  // Solution x minimizing the norm of A * x - b for every column of b.
+  // Throws if Rank() is less than the number of columns of A.
+  S21Matrix LeastSquares(const S21ConstMatrixView& b) const;
+
+  // Factors the m x n row-major matrix at a in place, storing the
+  // min(m, n) Householder scalars in tau and the original index of the
+  // j-th column of A * P in columns[j]. Returns det(Q) * det(P), which is
+  // 1 or -1. T is double or float.
+  template <typename T>
+  static int Factor(int m, int n, T* a, int lda, T* tau, int* columns);
+  // The same without pivoting, so A = Q * R. The work on tall matrices is
+  // split by rows over S21ThreadPool.
+  template <typename T>
+  static void Factor(int m, int n, T* a, int lda, T* tau);
+  // Overwrites the m x nrhs row-major matrix at b, rows ldb apart, with
+  // Q^T * b, given qr and tau from either Factor().
+  template <typename T>
+  static void ApplyQt(int m, int n, int nrhs, const T* qr, int ldqr,
+                      const T* tau, T* b, int ldb);
+  // The same with Q * b.
+  template <typename T>
+  static void ApplyQ(int m, int n, int nrhs, const T* qr, int ldqr,
+                     const T* tau, T* b, int ldb);
+  // Overwrites the n x nrhs matrix at b with R^-1 * b, where R is the upper
+  // triangle of the n x n matrix at r.
+  template <typename T>
+  static void Substitute(int n, int nrhs, const T* r, int ldr, T* b,
+                         int ldb);
+  // Writes the n x nrhs solution x minimizing the norm of A * x - B for the
+  // m x n matrix a, m >= n, into the matrix at x, rows ldx apart. Returns
+  // false, leaving x unspecified, if the columns of A are linearly
+  // dependent. T is double or float.
+  template <typename T>
+  static bool LeastSquares(const S21BasicMatrixView<const T>& a,
+                           const S21BasicMatrixView<const T>& b, T* x,
+                           int ldx);
+
+ private:
+  // Number of reflectors applied together as I - V * T * V^T.
+  static constexpr int kBlock = 32;
+
+  S21Matrix qr_;
+  std::vector<double> tau_;
+  std::vector<int> columns_;
+  int sign_{1};
+  int rank_{0};
+  mutable std::once_flag inverse_once_;
+  mutable S21Matrix inverse_;
+
+  void CheckSquare() const;
+};
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_QR_H_
@@ -0,0 +1,913 @@
+#include "s21_simd.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define S21_SIMD_X86 1
+#endif
+
+namespace {
+
+template <typename T>
+void AddScalar(long n, const T* x, T* y) {
+  for (long i = 0; i < n; ++i) {
+    y[i] += x[i];
+  }
+}
+
+template <typename T>
+void SubScalar(long n, const T* x, T* y) {
+  for (long i = 0; i < n; ++i) {
+    y[i] -= x[i];
+  }
+}
+
+template <typename T>
+void AxpyScalar(long n, T alpha, const T* x, T* y) {
+  for (long i = 0; i < n; ++i) {
+    y[i] += alpha * x[i];
+  }
+}
+
+template <typename T>
+void ScaleScalar(long n, T alpha, T* y) {
+  for (long i = 0; i < n; ++i) {
+    y[i] *= alpha;
+  }
+}
+
+template <typename T>
+bool EqualScalar(long n, const T* x, const T* y, double eps) {
+  bool equal = true;
+  for (long i = 0; i < n && equal; ++i) {
+    if constexpr (std::is_integral<T>::value) {
+      equal = x[i] == y[i];
+    } else if (!(std::abs(x[i] - y[i]) < eps)) {
+      equal = false;
+    }
+  }
+  return equal;
+}
+
+template <typename T>
+void GemmKernelScalar(int kc, T alpha, const T* a, const T* b, T* c,
+                      long ldc) {
+  constexpr int kMr = 4;
+  constexpr int kNr = 8;
+  T acc[kMr][kNr] = {};
+  for (int p = 0; p < kc; ++p) {
+    for (int i = 0; i < kMr; ++i) {
+      for (int j = 0; j < kNr; ++j) {
+        acc[i][j] += a[i] * b[j];
+      }
+    }
+    a += kMr;
+    b += kNr;
+  }
+  for (int i = 0; i < kMr; ++i) {
+    for (int j = 0; j < kNr; ++j) {
+      c[i * ldc + j] += alpha * acc[i][j];
+    }
+  }
+}
+
+template <typename T>
+void TransposeScalar(int rows, int cols, const T* a, long lda, T* b, long ldb,
+                     bool /*stream*/) {
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      b[j * ldb + i] = a[i * lda + j];
+    }
+  }
+}
+
+// Transposes the full tile x tile blocks of a rows x cols block with
+// tile_fn and the ragged right and bottom edges element by element. Tiles
+// are visited along the rows of B so that streamed stores to a row combine
+// into whole cache lines. Always inlined so that tile_fn is inlined into
+// each instruction set's caller.
+template <int tile, typename T, typename TileFn>
+inline __attribute__((always_inline)) void TransposeTiled(
+    int rows, int cols, const T* a, long lda, T* b, long ldb,
+    TileFn tile_fn) {
+  const int full_rows = rows - rows % tile;
+  const int full_cols = cols - cols % tile;
+  for (int j = 0; j < full_cols; j += tile) {
+    for (int i = 0; i < full_rows; i += tile) {
+      tile_fn(a + i * lda + j, lda, b + j * ldb + i, ldb);
+    }
+  }
+  TransposeScalar(full_rows, cols - full_cols, a + full_cols, lda,
+                  b + full_cols * ldb, ldb, false);
+  TransposeScalar(rows - full_rows, cols, a + full_rows * lda, lda,
+                  b + full_rows, ldb, false);
+}
+
+template <typename T>
+constexpr S21BasicKernels<T> kScalarKernels = {
+    S21Isa::kScalar,     4,
+    8,                   AddScalar<T>,
+    SubScalar<T>,        AxpyScalar<T>,
+    ScaleScalar<T>,      EqualScalar<T>,
+    GemmKernelScalar<T>, TransposeScalar<T>};
+
+#ifdef S21_SIMD_X86
+
+// Each instruction set's kernels are written once for double and float
+// against a traits struct naming the intrinsics of one register type.
+// Integer tables reuse the scalar kernels but transpose with the double
+// tiles, which only move 64-bit patterns around.
+
+// Whether tile x tile blocks of B can all be written with aligned streaming
+// stores of width bytes.
+template <typename T>
+bool CanStream(const T* b, long ldb, int tile, int width) noexcept {
+  return reinterpret_cast<std::uintptr_t>(b) % width == 0 && ldb % tile == 0;
+}
+
+// Runs TransposeTiled with streaming tiles when stream is set and B is
+// suitably aligned, and with plain stores otherwise.
+template <int tile, int width, typename T>
+inline __attribute__((always_inline)) void TransposeVector(
+    int rows, int cols, const T* a, long lda, T* b, long ldb, bool stream,
+    void (*stream_fn)(const T*, long, T*, long),
+    void (*store_fn)(const T*, long, T*, long)) {
+  if (stream && CanStream(b, ldb, tile, width)) {
+    TransposeTiled<tile>(rows, cols, a, lda, b, ldb, stream_fn);
+    _mm_sfence();
+  } else {
+    TransposeTiled<tile>(rows, cols, a, lda, b, ldb, store_fn);
+  }
+}
+
+// Tile function of the double kernels applied to 64-bit integers. The
+// intrinsics load and store through may-alias types.
+template <void (*tile_fn)(const double*, long, double*, long)>
+void Int64Tile(const std::int64_t* a, long lda, std::int64_t* b, long ldb) {
+  tile_fn(reinterpret_cast<const double*>(a), lda,
+          reinterpret_cast<double*>(b), ldb);
+}
+
+template <typename T>
+struct Sse2;
+
+template <>
+struct Sse2<double> {
+  using Vec = __m128d;
+  static constexpr int kWidth = 2;
+  static Vec Load(const double* p) { return _mm_loadu_pd(p); }
+  static void Store(double* p, Vec v) { _mm_storeu_pd(p, v); }
+  static Vec Set1(double x) { return _mm_set1_pd(x); }
+  static Vec Zero() { return _mm_setzero_pd(); }
+  static Vec Add(Vec x, Vec y) { return _mm_add_pd(x, y); }
+  static Vec Sub(Vec x, Vec y) { return _mm_sub_pd(x, y); }
+  static Vec Mul(Vec x, Vec y) { return _mm_mul_pd(x, y); }
+  // x * y + z
+  static Vec MulAdd(Vec x, Vec y, Vec z) {
+    return _mm_add_pd(_mm_mul_pd(x, y), z);
+  }
+  // Whether |x| < eps in every lane.
+  static bool AbsLess(Vec x, Vec eps) {
+    const Vec abs = _mm_andnot_pd(_mm_set1_pd(-0.0), x);
+    return _mm_movemask_pd(_mm_cmplt_pd(abs, eps)) == 0x3;
+  }
+};
+
+template <>
+struct Sse2<float> {
+  using Vec = __m128;
+  static constexpr int kWidth = 4;
+  static Vec Load(const float* p) { return _mm_loadu_ps(p); }
+  static void Store(float* p, Vec v) { _mm_storeu_ps(p, v); }
+  static Vec Set1(float x) { return _mm_set1_ps(x); }
+  static Vec Zero() { return _mm_setzero_ps(); }
+  static Vec Add(Vec x, Vec y) { return _mm_add_ps(x, y); }
+  static Vec Sub(Vec x, Vec y) { return _mm_sub_ps(x, y); }
+  static Vec Mul(Vec x, Vec y) { return _mm_mul_ps(x, y); }
+  static Vec MulAdd(Vec x, Vec y, Vec z) {
+    return _mm_add_ps(_mm_mul_ps(x, y), z);
+  }
+  static bool AbsLess(Vec x, Vec eps) {
+    const Vec abs = _mm_andnot_ps(_mm_set1_ps(-0.0f), x);
+    return _mm_movemask_ps(_mm_cmplt_ps(abs, eps)) == 0xF;
+  }
+};
+
+template <typename T>
+void AddSse2(long n, const T* x, T* y) {
+  using V = Sse2<T>;
+  long i = 0;
+  for (; i + V::kWidth <= n; i += V::kWidth) {
+    V::Store(y + i, V::Add(V::Load(y + i), V::Load(x + i)));
+  }
+  AddScalar(n - i, x + i, y + i);
+}
+
+template <typename T>
+void SubSse2(long n, const T* x, T* y) {
+  using V = Sse2<T>;
+  long i = 0;
+  for (; i + V::kWidth <= n; i += V::kWidth) {
+    V::Store(y + i, V::Sub(V::Load(y + i), V::Load(x + i)));
+  }
+  SubScalar(n - i, x + i, y + i);
+}
+
+template <typename T>
+void AxpySse2(long n, T alpha, const T* x, T* y) {
+  using V = Sse2<T>;
+  const typename V::Vec va = V::Set1(alpha);
+  long i = 0;
+  for (; i + V::kWidth <= n; i += V::kWidth) {
+    V::Store(y + i, V::MulAdd(va, V::Load(x + i), V::Load(y + i)));
+  }
+  AxpyScalar(n - i, alpha, x + i, y + i);
+}
+
+template <typename T>
+void ScaleSse2(long n, T alpha, T* y) {
+  using V = Sse2<T>;
+  const typename V::Vec va = V::Set1(alpha);
+  long i = 0;
+  for (; i + V::kWidth <= n; i += V::kWidth) {
+    V::Store(y + i, V::Mul(va, V::Load(y + i)));
+  }
+  ScaleScalar(n - i, alpha, y + i);
+}
+
+template <typename T>
+bool EqualSse2(long n, const T* x, const T* y, double eps) {
+  using V = Sse2<T>;
+  const typename V::Vec veps = V::Set1(static_cast<T>(eps));
+  bool equal = true;
+  long i = 0;
+  for (; i + V::kWidth <= n && equal; i += V::kWidth) {
+    equal = V::AbsLess(V::Sub(V::Load(x + i), V::Load(y + i)), veps);
+  }
+  return equal && EqualScalar(n - i, x + i, y + i, eps);
+}
+
+// 4 x 2w tile in eight xmm accumulators, w being the lanes per register.
+template <typename T>
+void GemmKernelSse2(int kc, T alpha, const T* a, const T* b, T* c,
+                    long ldc) {
+  using V = Sse2<T>;
+  typename V::Vec acc[4][2];
+  for (int i = 0; i < 4; ++i) {
+    acc[i][0] = V::Zero();
+    acc[i][1] = V::Zero();
+  }
+  for (int p = 0; p < kc; ++p) {
+    const typename V::Vec b0 = V::Load(b);
+    const typename V::Vec b1 = V::Load(b + V::kWidth);
+    for (int i = 0; i < 4; ++i) {
+      const typename V::Vec ai = V::Set1(a[i]);
+      acc[i][0] = V::MulAdd(ai, b0, acc[i][0]);
+      acc[i][1] = V::MulAdd(ai, b1, acc[i][1]);
+    }
+    a += 4;
+    b += 2 * V::kWidth;
+  }
+  const typename V::Vec va = V::Set1(alpha);
+  for (int i = 0; i < 4; ++i) {
+    T* c_row = c + i * ldc;
+    V::Store(c_row, V::MulAdd(va, acc[i][0], V::Load(c_row)));
+    V::Store(c_row + V::kWidth,
+             V::MulAdd(va, acc[i][1], V::Load(c_row + V::kWidth)));
+  }
+}
+
+// 2 x 2 double tiles swapped through unpack.
+template <bool stream>
+void TransposeTileSse2(const double* a, long lda, double* b, long ldb) {
+  const __m128d r0 = _mm_loadu_pd(a);
+  const __m128d r1 = _mm_loadu_pd(a + lda);
+  const __m128d c0 = _mm_unpacklo_pd(r0, r1);
+  const __m128d c1 = _mm_unpackhi_pd(r0, r1);
+  if (stream) {
+    _mm_stream_pd(b, c0);
+    _mm_stream_pd(b + ldb, c1);
+  } else {
+    _mm_storeu_pd(b, c0);
+    _mm_storeu_pd(b + ldb, c1);
+  }
+}
+
+// 4 x 4 float tiles.
+template <bool stream>
+void TransposeTileSse2(const float* a, long lda, float* b, long ldb) {
+  __m128 r[4];
+  for (int k = 0; k < 4; ++k) {
+    r[k] = _mm_loadu_ps(a + k * lda);
+  }
+  _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+  for (int k = 0; k < 4; ++k) {
+    if (stream) {
+      _mm_stream_ps(b + k * ldb, r[k]);
+    } else {
+      _mm_storeu_ps(b + k * ldb, r[k]);
+    }
+  }
+}
+
+void TransposeSse2(int rows, int cols, const double* a, long lda, double* b,
+                   long ldb, bool stream) {
+  TransposeVector<2, 16>(rows, cols, a, lda, b, ldb, stream,
+                         TransposeTileSse2<true>, TransposeTileSse2<false>);
+}
+
+void TransposeSse2(int rows, int cols, const float* a, long lda, float* b,
+                   long ldb, bool stream) {
+  TransposeVector<4, 16>(rows, cols, a, lda, b, ldb, stream,
+                         TransposeTileSse2<true>, TransposeTileSse2<false>);
+}
+
+void TransposeSse2(int rows, int cols, const std::int64_t* a, long lda,
+                   std::int64_t* b, long ldb, bool stream) {
+  TransposeVector<2, 16>(rows, cols, a, lda, b, ldb, stream,
+                         Int64Tile<TransposeTileSse2<true>>,
+                         Int64Tile<TransposeTileSse2<false>>);
+}
+
+template <typename T>
+constexpr S21BasicKernels<T> kSse2Kernels = {
+    S21Isa::kSse2,     4,
+    2 * Sse2<T>::kWidth, AddSse2<T>,
+    SubSse2<T>,        AxpySse2<T>,
+    ScaleSse2<T>,      EqualSse2<T>,
+    GemmKernelSse2<T>, TransposeSse2};
+
+template <>
+constexpr S21BasicKernels<std::int64_t> kSse2Kernels<std::int64_t> = {
+    S21Isa::kSse2,
+    4,
+    8,
+    AddScalar<std::int64_t>,
+    SubScalar<std::int64_t>,
+    AxpyScalar<std::int64_t>,
+    ScaleScalar<std::int64_t>,
+    EqualScalar<std::int64_t>,
+    GemmKernelScalar<std::int64_t>,
+    TransposeSse2};
+
+#define S21_TARGET_AVX2 __attribute__((target("avx2,fma")))
+
+template <typename T>
+struct Avx2;
+
+template <>
+struct Avx2<double> {
+  using Vec = __m256d;
+  static constexpr int kWidth = 4;
+  S21_TARGET_AVX2 static Vec Load(const double* p) {
+    return _mm256_loadu_pd(p);
+  }
+  S21_TARGET_AVX2 static void Store(double* p, Vec v) {
+    _mm256_storeu_pd(p, v);
+  }
+  S21_TARGET_AVX2 static Vec Set1(double x) { return _mm256_set1_pd(x); }
+  S21_TARGET_AVX2 static Vec Zero() { return _mm256_setzero_pd(); }
+  S21_TARGET_AVX2 static Vec Add(Vec x, Vec y) { return _mm256_add_pd(x, y); }
+  S21_TARGET_AVX2 static Vec Sub(Vec x, Vec y) { return _mm256_sub_pd(x, y); }
+  S21_TARGET_AVX2 static Vec Mul(Vec x, Vec y) { return _mm256_mul_pd(x, y); }
+  S21_TARGET_AVX2 static Vec MulAdd(Vec x, Vec y, Vec z) {
+    return _mm256_fmadd_pd(x, y, z);
+  }
+  S21_TARGET_AVX2 static bool AbsLess(Vec x, Vec eps) {
+    const Vec abs = _mm256_andnot_pd(_mm256_set1_pd(-0.0), x);
+    return _mm256_movemask_pd(_mm256_cmp_pd(abs, eps, _CMP_LT_OQ)) == 0xF;
+  }
+};
+
+template <>
+struct Avx2<float> {
+  using Vec = __m256;
+  static constexpr int kWidth = 8;
+  S21_TARGET_AVX2 static Vec Load(const float* p) {
+    return _mm256_loadu_ps(p);
+  }
+  S21_TARGET_AVX2 static void Store(float* p, Vec v) {
+    _mm256_storeu_ps(p, v);
+  }
+  S21_TARGET_AVX2 static Vec Set1(float x) { return _mm256_set1_ps(x); }
+  S21_TARGET_AVX2 static Vec Zero() { return _mm256_setzero_ps(); }
+  S21_TARGET_AVX2 static Vec Add(Vec x, Vec y) { return _mm256_add_ps(x, y); }
+  S21_TARGET_AVX2 static Vec Sub(Vec x, Vec y) { return _mm256_sub_ps(x, y); }
+  S21_TARGET_AVX2 static Vec Mul(Vec x, Vec y) { return _mm256_mul_ps(x, y); }
+  S21_TARGET_AVX2 static Vec MulAdd(Vec x, Vec y, Vec z) {
+    return _mm256_fmadd_ps(x, y, z);
+  }
+  S21_TARGET_AVX2 static bool AbsLess(Vec x, Vec eps) {
+    const Vec abs = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x);
+    return _mm256_movemask_ps(_mm256_cmp_ps(abs, eps, _CMP_LT_OQ)) == 0xFF;
+  }
+};
+
+template <typename T>
+S21_TARGET_AVX2 void AddAvx2(long n, const T* x, T* y) {
+  using V = Avx2<T>;
+  long i = 0;
+  for (; i + V::kWidth <= n; i += V::kWidth) {
+    V::Store(y + i, V::Add(V::Load(y + i), V::Load(x + i)));
+  }
+  AddScalar(n - i, x + i, y + i);
+}
+
+template <typename T>
+S21_TARGET_AVX2 void SubAvx2(long n, const T* x, T* y) {
+  using V = Avx2<T>;
+  long i = 0;
+  for (; i + V::kWidth <= n; i += V::kWidth) {
+    V::Store(y + i, V::Sub(V::Load(y + i), V::Load(x + i)));
+  }
+  SubScalar(n - i, x + i, y + i);
+}
+
+template <typename T>
+S21_TARGET_AVX2 void AxpyAvx2(long n, T alpha, const T* x, T* y) {
+  using V = Avx2<T>;
+  const typename V::Vec va = V::Set1(alpha);
+  long i = 0;
+  for (; i + V::kWidth <= n; i += V::kWidth) {
+    V::Store(y + i, V::MulAdd(va, V::Load(x + i), V::Load(y + i)));
+  }
+  AxpyScalar(n - i, alpha, x + i, y + i);
+}
+
+template <typename T>
+S21_TARGET_AVX2 void ScaleAvx2(long n, T alpha, T* y) {
+  using V = Avx2<T>;
+  const typename V::Vec va = V::Set1(alpha);
+  long i = 0;
+  for (; i + V::kWidth <= n; i += V::kWidth) {
+    V::Store(y + i, V::Mul(va, V::Load(y + i)));
+  }
+  ScaleScalar(n - i, alpha, y + i);
+}
+
+template <typename T>
+S21_TARGET_AVX2 bool EqualAvx2(long n, const T* x, const T* y, double eps) {
+  using V = Avx2<T>;
+  const typename V::Vec veps = V::Set1(static_cast<T>(eps));
+  bool equal = true;
+  long i = 0;
+  for (; i + V::kWidth <= n && equal; i += V::kWidth) {
+    equal = V::AbsLess(V::Sub(V::Load(x + i), V::Load(y + i)), veps);
+  }
+  return equal && EqualScalar(n - i, x + i, y + i, eps);
+}
+
+// 4 x 2w tile in eight ymm accumulators.
+template <typename T>
+S21_TARGET_AVX2 void GemmKernelAvx2(int kc, T alpha, const T* a, const T* b,
+                                    T* c, long ldc) {
+  using V = Avx2<T>;
+  typename V::Vec acc[4][2];
+  for (int i = 0; i < 4; ++i) {
+    acc[i][0] = V::Zero();
+    acc[i][1] = V::Zero();
+  }
+  for (int p = 0; p < kc; ++p) {
+    const typename V::Vec b0 = V::Load(b);
+    const typename V::Vec b1 = V::Load(b + V::kWidth);
+    for (int i = 0; i < 4; ++i) {
+      const typename V::Vec ai = V::Set1(a[i]);
+      acc[i][0] = V::MulAdd(ai, b0, acc[i][0]);
+      acc[i][1] = V::MulAdd(ai, b1, acc[i][1]);
+    }
+    a += 4;
+    b += 2 * V::kWidth;
+  }
+  const typename V::Vec va = V::Set1(alpha);
+  for (int i = 0; i < 4; ++i) {
+    T* c_row = c + i * ldc;
+    V::Store(c_row, V::MulAdd(va, acc[i][0], V::Load(c_row)));
+    V::Store(c_row + V::kWidth,
+             V::MulAdd(va, acc[i][1], V::Load(c_row + V::kWidth)));
+  }
+}
+
+// 4 x 4 double tile: pairs of rows are interleaved within 128-bit lanes,
+// then the lanes are exchanged.
+template <bool stream>
+S21_TARGET_AVX2 void TransposeTileAvx2(const double* a, long lda, double* b,
+                                       long ldb) {
+  const __m256d r0 = _mm256_loadu_pd(a);
+  const __m256d r1 = _mm256_loadu_pd(a + lda);
+  const __m256d r2 = _mm256_loadu_pd(a + 2 * lda);
+  const __m256d r3 = _mm256_loadu_pd(a + 3 * lda);
+  const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+  const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+  const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+  const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+  const __m256d c[4] = {_mm256_permute2f128_pd(t0, t2, 0x20),
+                        _mm256_permute2f128_pd(t1, t3, 0x20),
+                        _mm256_permute2f128_pd(t0, t2, 0x31),
+                        _mm256_permute2f128_pd(t1, t3, 0x31)};
+  for (int k = 0; k < 4; ++k) {
+    if (stream) {
+      _mm256_stream_pd(b + k * ldb, c[k]);
+    } else {
+      _mm256_storeu_pd(b + k * ldb, c[k]);
+    }
+  }
+}
+
+// 8 x 8 float tile: rows are interleaved in pairs and then in fours within
+// 128-bit lanes, and the lanes are exchanged last.
+template <bool stream>
+S21_TARGET_AVX2 void TransposeTileAvx2(const float* a, long lda, float* b,
+                                       long ldb) {
+  __m256 t[8];
+  for (int i = 0; i < 8; i += 2) {
+    const __m256 r0 = _mm256_loadu_ps(a + i * lda);
+    const __m256 r1 = _mm256_loadu_ps(a + (i + 1) * lda);
+    t[i] = _mm256_unpacklo_ps(r0, r1);
+    t[i + 1] = _mm256_unpackhi_ps(r0, r1);
+  }
+  __m256 s[8];
+  for (int i = 0; i < 8; i += 4) {
+    s[i] = _mm256_shuffle_ps(t[i], t[i + 2], 0x44);
+    s[i + 1] = _mm256_shuffle_ps(t[i], t[i + 2], 0xEE);
+    s[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], 0x44);
+    s[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], 0xEE);
+  }
+  for (int k = 0; k < 4; ++k) {
+    const __m256 lo = _mm256_permute2f128_ps(s[k], s[k + 4], 0x20);
+    const __m256 hi = _mm256_permute2f128_ps(s[k], s[k + 4], 0x31);
+    if (stream) {
+      _mm256_stream_ps(b + k * ldb, lo);
+      _mm256_stream_ps(b + (k + 4) * ldb, hi);
+    } else {
+      _mm256_storeu_ps(b + k * ldb, lo);
+      _mm256_storeu_ps(b + (k + 4) * ldb, hi);
+    }
+  }
+}
+
+S21_TARGET_AVX2 void TransposeAvx2(int rows, int cols, const double* a,
+                                   long lda, double* b, long ldb,
+                                   bool stream) {
+  TransposeVector<4, 32>(rows, cols, a, lda, b, ldb, stream,
+                         TransposeTileAvx2<true>, TransposeTileAvx2<false>);
+}
+
+S21_TARGET_AVX2 void TransposeAvx2(int rows, int cols, const float* a,
+                                   long lda, float* b, long ldb,
+                                   bool stream) {
+  TransposeVector<8, 32>(rows, cols, a, lda, b, ldb, stream,
+                         TransposeTileAvx2<true>, TransposeTileAvx2<false>);
+}
+
+S21_TARGET_AVX2 void TransposeAvx2(int rows, int cols, const std::int64_t* a,
+                                   long lda, std::int64_t* b, long ldb,
+                                   bool stream) {
+  TransposeVector<4, 32>(rows, cols, a, lda, b, ldb, stream,
+                         Int64Tile<TransposeTileAvx2<true>>,
+                         Int64Tile<TransposeTileAvx2<false>>);
+}
+
+template <typename T>
+constexpr S21BasicKernels<T> kAvx2Kernels = {
+    S21Isa::kAvx2,     4,
+    2 * Avx2<T>::kWidth, AddAvx2<T>,
+    SubAvx2<T>,        AxpyAvx2<T>,
+    ScaleAvx2<T>,      EqualAvx2<T>,
+    GemmKernelAvx2<T>, TransposeAvx2};
+
+template <>
+constexpr S21BasicKernels<std::int64_t> kAvx2Kernels<std::int64_t> = {
+    S21Isa::kAvx2,
+    4,
+    8,
+    AddScalar<std::int64_t>,
+    SubScalar<std::int64_t>,
+    AxpyScalar<std::int64_t>,
+    ScaleScalar<std::int64_t>,
+    EqualScalar<std::int64_t>,
+    GemmKernelScalar<std::int64_t>,
+    TransposeAvx2};
+
+#define S21_TARGET_AVX512 __attribute__((target("avx512f")))
+
+template <typename T>
+struct Avx512;
+
+template <>
+struct Avx512<double> {
+  using Vec = __m512d;
+  static constexpr int kWidth = 8;
+  S21_TARGET_AVX512 static Vec Load(const double* p) {
+    return _mm512_loadu_pd(p);
+  }
+  S21_TARGET_AVX512 static void Store(double* p, Vec v) {
+    _mm512_storeu_pd(p, v);
+  }
+  S21_TARGET_AVX512 static Vec Set1(double x) { return _mm512_set1_pd(x); }
+  S21_TARGET_AVX512 static Vec Zero() { return _mm512_setzero_pd(); }
+  S21_TARGET_AVX512 static Vec Add(Vec x, Vec y) {
+    return _mm512_add_pd(x, y);
+  }
+  S21_TARGET_AVX512 static Vec Sub(Vec x, Vec y) {
+    return _mm512_sub_pd(x, y);
+  }
+  S21_TARGET_AVX512 static Vec Mul(Vec x, Vec y) {
+    return _mm512_mul_pd(x, y);
+  }
+  S21_TARGET_AVX512 static Vec MulAdd(Vec x, Vec y, Vec z) {
+    return _mm512_fmadd_pd(x, y, z);
+  }
+  S21_TARGET_AVX512 static bool AbsLess(Vec x, Vec eps) {
+    return _mm512_cmp_pd_mask(_mm512_abs_pd(x), eps, _CMP_LT_OQ) == 0xFF;
+  }
+};
+
+template <>
+struct Avx512<float> {
+  using Vec = __m512;
+  static constexpr int kWidth = 16;
+  S21_TARGET_AVX512 static Vec Load(const float* p) {
+    return _mm512_loadu_ps(p);
+  }
+  S21_TARGET_AVX512 static void Store(float* p, Vec v) {
+    _mm512_storeu_ps(p, v);
+  }
+  S21_TARGET_AVX512 static Vec Set1(float x) { return _mm512_set1_ps(x); }
+  S21_TARGET_AVX512 static Vec Zero() { return _mm512_setzero_ps(); }
+  S21_TARGET_AVX512 static Vec Add(Vec x, Vec y) {
+    return _mm512_add_ps(x, y);
+  }
+  S21_TARGET_AVX512 static Vec Sub(Vec x, Vec y) {
+    return _mm512_sub_ps(x, y);
+  }
+  S21_TARGET_AVX512 static Vec Mul(Vec x, Vec y) {
+    return _mm512_mul_ps(x, y);
+  }
+  S21_TARGET_AVX512 static Vec MulAdd(Vec x, Vec y, Vec z) {
+    return _mm512_fmadd_ps(x, y, z);
+  }
+  S21_TARGET_AVX512 static bool AbsLess(Vec x, Vec eps) {
+    return _mm512_cmp_ps_mask(_mm512_abs_ps(x), eps, _CMP_LT_OQ) == 0xFFFF;
+  }
+};
+
+template <typename T>
+S21_TARGET_AVX512 void AddAvx512(long n, const T* x, T* y) {
+  using V = Avx512<T>;
+  long i = 0;
+  for (; i + V::kWidth <= n; i += V::kWidth) {
+    V::Store(y + i, V::Add(V::Load(y + i), V::Load(x + i)));
+  }
+  AddScalar(n - i, x + i, y + i);
+}
+
+template <typename T>
+S21_TARGET_AVX512 void SubAvx512(long n, const T* x, T* y) {
+  using V = Avx512<T>;
+  long i = 0;
+  for (; i + V::kWidth <= n; i += V::kWidth) {
+    V::Store(y + i, V::Sub(V::Load(y + i), V::Load(x + i)));
+  }
+  SubScalar(n - i, x + i, y + i);
+}
+
+template <typename T>
+S21_TARGET_AVX512 void AxpyAvx512(long n, T alpha, const T* x, T* y) {
+  using V = Avx512<T>;
+  const typename V::Vec va = V::Set1(alpha);
+  long i = 0;
+  for (; i + V::kWidth <= n; i += V::kWidth) {
+    V::Store(y + i, V::MulAdd(va, V::Load(x + i), V::Load(y + i)));
+  }
+  AxpyScalar(n - i, alpha, x + i, y + i);
+}
+
+template <typename T>
+S21_TARGET_AVX512 void ScaleAvx512(long n, T alpha, T* y) {
+  using V = Avx512<T>;
+  const typename V::Vec va = V::Set1(alpha);
+  long i = 0;
+  for (; i + V::kWidth <= n; i += V::kWidth) {
+    V::Store(y + i, V::Mul(va, V::Load(y + i)));
+  }
+  ScaleScalar(n - i, alpha, y + i);
+}
+
+template <typename T>
+S21_TARGET_AVX512 bool EqualAvx512(long n, const T* x, const T* y,
+                                   double eps) {
+  using V = Avx512<T>;
+  const typename V::Vec veps = V::Set1(static_cast<T>(eps));
+  bool equal = true;
+  long i = 0;
+  for (; i + V::kWidth <= n && equal; i += V::kWidth) {
+    equal = V::AbsLess(V::Sub(V::Load(x + i), V::Load(y + i)), veps);
+  }
+  return equal && EqualScalar(n - i, x + i, y + i, eps);
+}
+
+// 8 x w tile in eight zmm accumulators.
+template <typename T>
+S21_TARGET_AVX512 void GemmKernelAvx512(int kc, T alpha, const T* a,
+                                        const T* b, T* c, long ldc) {
+  using V = Avx512<T>;
+  typename V::Vec acc[8];
+  for (int i = 0; i < 8; ++i) {
+    acc[i] = V::Zero();
+  }
+  for (int p = 0; p < kc; ++p) {
+    const typename V::Vec b0 = V::Load(b);
+    for (int i = 0; i < 8; ++i) {
+      acc[i] = V::MulAdd(V::Set1(a[i]), b0, acc[i]);
+    }
+    a += 8;
+    b += V::kWidth;
+  }
+  const typename V::Vec va = V::Set1(alpha);
+  for (int i = 0; i < 8; ++i) {
+    T* c_row = c + i * ldc;
+    V::Store(c_row, V::MulAdd(va, acc[i], V::Load(c_row)));
+  }
+}
+
+// 8 x 8 double tile: pairs of rows are interleaved, then 128-bit lanes are
+// gathered in two rounds of two-source permutes.
+template <bool stream>
+S21_TARGET_AVX512 void TransposeTileAvx512(const double* a, long lda,
+                                           double* b, long ldb) {
+  const __m512i interleave_lo = _mm512_setr_epi64(0, 8, 2, 10, 4, 12, 6, 14);
+  const __m512i interleave_hi = _mm512_setr_epi64(1, 9, 3, 11, 5, 13, 7, 15);
+  const __m512i even_lanes = _mm512_setr_epi64(0, 1, 4, 5, 8, 9, 12, 13);
+  const __m512i odd_lanes = _mm512_setr_epi64(2, 3, 6, 7, 10, 11, 14, 15);
+  __m512d t[8];
+  for (int i = 0; i < 8; i += 2) {
+    const __m512d r0 = _mm512_loadu_pd(a + i * lda);
+    const __m512d r1 = _mm512_loadu_pd(a + (i + 1) * lda);
+    t[i] = _mm512_permutex2var_pd(r0, interleave_lo, r1);
+    t[i + 1] = _mm512_permutex2var_pd(r0, interleave_hi, r1);
+  }
+  __m512d c[8];
+  for (int k = 0; k < 2; ++k) {
+    const __m512d even0 = _mm512_permutex2var_pd(t[k], even_lanes, t[k + 2]);
+    const __m512d odd0 = _mm512_permutex2var_pd(t[k], odd_lanes, t[k + 2]);
+    const __m512d even1 =
+        _mm512_permutex2var_pd(t[k + 4], even_lanes, t[k + 6]);
+    const __m512d odd1 = _mm512_permutex2var_pd(t[k + 4], odd_lanes, t[k + 6]);
+    c[k] = _mm512_permutex2var_pd(even0, even_lanes, even1);
+    c[k + 4] = _mm512_permutex2var_pd(even0, odd_lanes, even1);
+    c[k + 2] = _mm512_permutex2var_pd(odd0, even_lanes, odd1);
+    c[k + 6] = _mm512_permutex2var_pd(odd0, odd_lanes, odd1);
+  }
+  for (int k = 0; k < 8; ++k) {
+    if (stream) {
+      _mm512_stream_pd(b + k * ldb, c[k]);
+    } else {
+      _mm512_storeu_pd(b + k * ldb, c[k]);
+    }
+  }
+}
+
+S21_TARGET_AVX512 void TransposeAvx512(int rows, int cols, const double* a,
+                                       long lda, double* b, long ldb,
+                                       bool stream) {
+  TransposeVector<8, 64>(rows, cols, a, lda, b, ldb, stream,
+                         TransposeTileAvx512<true>,
+                         TransposeTileAvx512<false>);
+}
+
+S21_TARGET_AVX512 void TransposeAvx512(int rows, int cols,
+                                       const std::int64_t* a, long lda,
+                                       std::int64_t* b, long ldb,
+                                       bool stream) {
+  TransposeVector<8, 64>(rows, cols, a, lda, b, ldb, stream,
+                         Int64Tile<TransposeTileAvx512<true>>,
+                         Int64Tile<TransposeTileAvx512<false>>);
+}
+
+// Float transposes keep the 8 x 8 ymm tiles, which already fill a cache
+// line per row of B.
+template <typename T>
+constexpr S21BasicKernels<T> kAvx512Kernels = {
+    S21Isa::kAvx512,     8,
+    Avx512<T>::kWidth,   AddAvx512<T>,
+    SubAvx512<T>,        AxpyAvx512<T>,
+    ScaleAvx512<T>,      EqualAvx512<T>,
+    GemmKernelAvx512<T>, TransposeAvx512};
+
+template <>
+constexpr S21BasicKernels<float> kAvx512Kernels<float> = {
+    S21Isa::kAvx512,         8,
+    Avx512<float>::kWidth,   AddAvx512<float>,
+    SubAvx512<float>,        AxpyAvx512<float>,
+    ScaleAvx512<float>,      EqualAvx512<float>,
+    GemmKernelAvx512<float>, TransposeAvx2};
+
+template <>
+constexpr S21BasicKernels<std::int64_t> kAvx512Kernels<std::int64_t> = {
+    S21Isa::kAvx512,
+    4,
+    8,
+    AddScalar<std::int64_t>,
+    SubScalar<std::int64_t>,
+    AxpyScalar<std::int64_t>,
+    ScaleScalar<std::int64_t>,
+    EqualScalar<std::int64_t>,
+    GemmKernelScalar<std::int64_t>,
+    TransposeAvx512};
+
+#endif  // S21_SIMD_X86
+
+template <typename T>
+const S21BasicKernels<T>& KernelsFor(S21Isa isa) noexcept {
+  const S21BasicKernels<T>* kernels = &kScalarKernels<T>;
+#ifdef S21_SIMD_X86
+  if (isa == S21Isa::kAvx512) {
+    kernels = &kAvx512Kernels<T>;
+  } else if (isa == S21Isa::kAvx2) {
+    kernels = &kAvx2Kernels<T>;
+  } else if (isa == S21Isa::kSse2) {
+    kernels = &kSse2Kernels<T>;
+  }
+#else
+  (void)isa;
+#endif
+  return *kernels;
+}
+
+// Instruction set requested through S21_MATRIX_ISA, widest if unset.
+S21Isa RequestedIsa() noexcept {
+  S21Isa isa = S21Isa::kAvx512;
+  const char* name = std::getenv("S21_MATRIX_ISA");
+  if (name) {
+    for (S21Isa candidate : {S21Isa::kScalar, S21Isa::kSse2, S21Isa::kAvx2,
+                             S21Isa::kAvx512}) {
+      if (std::strcmp(name, S21IsaName(candidate)) == 0) {
+        isa = candidate;
+      }
+    }
+  }
+  return isa;
+}
+
+// Selected instruction set, or -1 before the first use.
+std::atomic<int> active_isa{-1};
+
+}  // namespace
+
+template <typename T>
+const S21BasicKernels<T>& S21ActiveKernels() noexcept {
+  return KernelsFor<T>(S21ActiveIsa());
+}
+
+template const S21BasicKernels<double>& S21ActiveKernels() noexcept;
+template const S21BasicKernels<float>& S21ActiveKernels() noexcept;
+template const S21BasicKernels<std::int64_t>& S21ActiveKernels() noexcept;
+
+S21Isa S21ActiveIsa() noexcept {
+  int isa = active_isa.load(std::memory_order_acquire);
+  if (isa < 0) {
+    isa = static_cast<int>(S21SelectIsa(RequestedIsa()));
+  }
+  return static_cast<S21Isa>(isa);
+}
+
+S21Isa S21DetectIsa() noexcept {
+  S21Isa isa = S21Isa::kScalar;
+#ifdef S21_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    isa = S21Isa::kAvx512;
+  } else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    isa = S21Isa::kAvx2;
+  } else if (__builtin_cpu_supports("sse2")) {
+    isa = S21Isa::kSse2;
+  }
+#endif
+  return isa;
+}
+
+S21Isa S21SelectIsa(S21Isa isa) noexcept {
+  const S21Isa supported = S21DetectIsa();
+  const S21Isa selected = isa < supported ? isa : supported;
+  active_isa.store(static_cast<int>(selected), std::memory_order_release);
+  return selected;
+}
+
+const char* S21IsaName(S21Isa isa) noexcept {
+  const char* name = "scalar";
+  if (isa == S21Isa::kSse2) {
+    name = "sse2";
+  } else if (isa == S21Isa::kAvx2) {
+    name = "avx2";
+  } else if (isa == S21Isa::kAvx512) {
+    name = "avx512";
+  }
+  return name;
+}
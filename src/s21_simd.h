@@ -0,0 +1,57 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_SIMD_H_
+#define CPP_S21_MATRIXPLUS_SRC_S21_SIMD_H_
+
+// Instruction sets the vector kernels are built for, from narrowest to
+// widest. The widest one the CPU supports is picked on first use; setting
+// the S21_MATRIX_ISA environment variable to one of the names returned by
+// S21IsaName() caps the choice.
+enum class S21Isa { kScalar, kSse2, kAvx2, kAvx512 };
+
+// Vector kernels for one instruction set and element type T. Element counts
+// are in elements of T and no alignment is required.
+template <typename T>
+struct S21BasicKernels {
+  S21Isa isa;
+  // Register tile of gemm_kernel, in rows of A and columns of B.
+  int gemm_mr;
+  int gemm_nr;
+  // y += x
+  void (*add)(long n, const T* x, T* y);
+  // y -= x
+  void (*sub)(long n, const T* x, T* y);
+  // y += alpha * x
+  void (*axpy)(long n, T alpha, const T* x, T* y);
+  // y *= alpha
+  void (*scale)(long n, T alpha, T* y);
+  // true if |x[i] - y[i]| < eps for every i; integers must match exactly.
+  bool (*equal)(long n, const T* x, const T* y, double eps);
+  // C[0:gemm_mr, 0:gemm_nr] += alpha * A * B over kc steps, with A packed as
+  // gemm_mr-row columns and B as gemm_nr-column rows.
+  void (*gemm_kernel)(int kc, T alpha, const T* a, const T* b, T* c,
+                      long ldc);
+  // B = A^T for a rows x cols block of A; B is cols x rows. The blocks must
+  // not overlap. With stream set, B is written around the cache where its
+  // alignment allows, which pays off when B is too large to stay cached.
+  void (*transpose)(int rows, int cols, const T* a, long lda, T* b, long ldb,
+                    bool stream);
+};
+
+using S21Kernels = S21BasicKernels<double>;
+
+// Kernels for the currently selected instruction set. There are kernels for
+// double, float and std::int64_t. Float registers hold twice as many
+// elements, so its GEMM tile is twice as wide. The instruction sets below
+// AVX-512DQ have no 64-bit integer multiply, so integers only use vector
+// code to transpose and otherwise run the scalar kernels, which the
+// compiler vectorizes where it can.
+template <typename T = double>
+const S21BasicKernels<T>& S21ActiveKernels() noexcept;
+S21Isa S21ActiveIsa() noexcept;
+// Widest instruction set supported by this CPU and operating system.
+S21Isa S21DetectIsa() noexcept;
+// Switches to the given instruction set, or to the widest supported one
+// below it, and returns the instruction set actually selected.
+S21Isa S21SelectIsa(S21Isa isa) noexcept;
+const char* S21IsaName(S21Isa isa) noexcept;
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_SIMD_H_
@@ -0,0 +1,153 @@
+#include "s21_thread_pool.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+// Set while the current thread executes pool tasks, so nested jobs run
+// serially instead of waiting on workers that are already busy.
+thread_local bool in_pool_task = false;
+
+int DefaultThreadCount() {
+  int threads = static_cast<int>(std::thread::hardware_concurrency());
+  const char* env = std::getenv("S21_MATRIX_THREADS");
+  if (env && std::atoi(env) > 0) {
+    threads = std::atoi(env);
+  }
+  return std::max(threads, 1);
+}
+
+}  // namespace
+
+S21ThreadPool& S21ThreadPool::Instance() {
+  static S21ThreadPool pool;
+  return pool;
+}
+
+S21ThreadPool::S21ThreadPool() { StartWorkers(DefaultThreadCount() - 1); }
+
+S21ThreadPool::~S21ThreadPool() { StopWorkers(); }
+
+int S21ThreadPool::Size() const noexcept { return size_.load(); }
+
+void S21ThreadPool::Resize(int threads) {
+  std::lock_guard<std::mutex> run_lock(run_mutex_);
+  StopWorkers();
+  StartWorkers(std::max(threads, 1) - 1);
+}
+
+void S21ThreadPool::Run(int tasks, const std::function<void(int)>& task) {
+  std::unique_lock<std::mutex> run_lock(run_mutex_, std::try_to_lock);
+  if (!run_lock || workers_.empty() || tasks <= 1 || in_pool_task) {
+    for (int i = 0; i < tasks; ++i) {
+      task(i);
+    }
+  } else {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return active_ == 0; });
+    task_ = &task;
+    tasks_ = tasks;
+    next_ = 0;
+    remaining_ = tasks;
+    failed_ = false;
+    ++generation_;
+    lock.unlock();
+    wake_.notify_all();
+    Drain();
+    lock.lock();
+    done_.wait(lock, [this] { return remaining_ == 0 && active_ == 0; });
+    std::exception_ptr error = std::move(error_);
+    error_ = nullptr;
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+void S21ThreadPool::StartWorkers(int count) {
+  stop_ = false;
+  for (int i = 0; i < count; ++i) {
+    workers_.emplace_back(&S21ThreadPool::WorkerLoop, this);
+  }
+  size_ = count + 1;
+}
+
+void S21ThreadPool::StopWorkers() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+  size_ = 1;
+}
+
+void S21ThreadPool::WorkerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  unsigned long seen = generation_;
+  while (!stop_) {
+    if (generation_ != seen) {
+      seen = generation_;
+      ++active_;
+      lock.unlock();
+      Drain();
+      lock.lock();
+      --active_;
+      done_.notify_all();
+    } else {
+      wake_.wait(lock);
+    }
+  }
+}
+
+// Claims and runs tasks of the current job until none are left. A job is
+// only replaced once every worker has left Drain(), so task_ and tasks_ are
+// stable here. An exception thrown by a task is kept for Run() to rethrow
+// on the calling thread, and the tasks claimed after it are only counted.
+void S21ThreadPool::Drain() {
+  const bool nested = in_pool_task;
+  in_pool_task = true;
+  for (int i = next_.fetch_add(1); i < tasks_; i = next_.fetch_add(1)) {
+    if (!failed_) {
+      try {
+        (*task_)(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!error_) {
+          error_ = std::current_exception();
+        }
+        failed_ = true;
+      }
+    }
+    if (remaining_.fetch_sub(1) == 1) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      done_.notify_all();
+    }
+  }
+  in_pool_task = nested;
+}
+
+void S21SetThreadCount(int threads) {
+  S21ThreadPool::Instance().Resize(threads);
+}
+
+int S21ThreadCount() noexcept { return S21ThreadPool::Instance().Size(); }
+
+void S21ParallelFor(int begin, int end, int grain,
+                    const std::function<void(int, int)>& fn) {
+  const int count = end - begin;
+  const int chunks = std::min(std::max(count / std::max(grain, 1), 1),
+                              S21ThreadCount() * 4);
+  if (chunks <= 1) {
+    fn(begin, end);
+  } else {
+    S21ThreadPool::Instance().Run(chunks, [&](int chunk) {
+      fn(begin + static_cast<long>(count) * chunk / chunks,
+         begin + static_cast<long>(count) * (chunk + 1) / chunks);
+    });
+  }
+}
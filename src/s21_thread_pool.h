@@ -0,0 +1,67 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_THREAD_POOL_H_
+#define CPP_S21_MATRIXPLUS_SRC_S21_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fork-join pool shared by the matrix kernels. The calling thread takes part
+// in every job, so a pool of size n owns n - 1 worker threads. The initial
+// size comes from the S21_MATRIX_THREADS environment variable, or from the
+// number of hardware threads if it is unset.
+class S21ThreadPool {
+ public:
+  static S21ThreadPool& Instance();
+
+  S21ThreadPool(const S21ThreadPool&) = delete;
+  S21ThreadPool& operator=(const S21ThreadPool&) = delete;
+  ~S21ThreadPool();
+
+  int Size() const noexcept;
+  void Resize(int threads);
+  // Calls task(i) for every i in [0, tasks) and returns once all calls have
+  // finished. Jobs submitted from inside a task, or while another thread's
+  // job is running, run serially on the calling thread. If a task throws,
+  // the tasks not yet started are skipped and the first exception is
+  // rethrown here once the rest have finished.
+  void Run(int tasks, const std::function<void(int)>& task);
+
+ private:
+  S21ThreadPool();
+
+  void StartWorkers(int count);
+  void StopWorkers();
+  void WorkerLoop();
+  void Drain();
+
+  std::vector<std::thread> workers_;
+  std::atomic<int> size_{1};
+  std::mutex run_mutex_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  const std::function<void(int)>* task_ = nullptr;
+  int tasks_{0};
+  std::atomic<int> next_{0};
+  std::atomic<int> remaining_{0};
+  std::atomic<bool> failed_{false};
+  std::exception_ptr error_;
+  int active_{0};
+  unsigned long generation_{0};
+  bool stop_{false};
+};
+
+void S21SetThreadCount(int threads);
+int S21ThreadCount() noexcept;
+
+// Splits [begin, end) into contiguous chunks of at least grain items and
+// calls fn(chunk_begin, chunk_end) for each of them on the pool. Ranges no
+// longer than grain run inline without touching the pool.
+void S21ParallelFor(int begin, int end, int grain,
+                    const std::function<void(int, int)>& fn);
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_THREAD_POOL_H_
@@ -0,0 +1,137 @@
+#include "s21_transpose.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include "s21_arena.h"
+#include "s21_simd.h"
+
+namespace {
+
+// Blocks of at most kLeaf x kLeaf elements go to the kernel; a source and
+// destination pair of them takes 16 KiB.
+constexpr int kLeaf = 32;
+
+// Destinations of more elements than this are written with streaming
+// stores: they cannot stay in cache, and bypassing it saves reading every
+// destination line before it is overwritten.
+constexpr long kStreamSize = 1 << 20;
+
+// Where to split a dimension longer than kLeaf: near the middle, at a
+// multiple of the widest kernel tile so leaves start on tile boundaries.
+int Split(int n) noexcept { return n / 2 / 8 * 8; }
+
+template <typename T>
+void TransposeBlocks(const S21BasicKernels<T>& kernels, int rows, int cols,
+                     const T* a, long lda, T* b, long ldb,
+                     bool stream) noexcept {
+  if (rows <= kLeaf && cols <= kLeaf) {
+    kernels.transpose(rows, cols, a, lda, b, ldb, stream);
+  } else if (rows >= cols) {
+    const int half = Split(rows);
+    TransposeBlocks(kernels, half, cols, a, lda, b, ldb, stream);
+    TransposeBlocks(kernels, rows - half, cols, a + half * lda, lda, b + half,
+                    ldb, stream);
+  } else {
+    const int half = Split(cols);
+    TransposeBlocks(kernels, rows, half, a, lda, b, ldb, stream);
+    TransposeBlocks(kernels, rows, cols - half, a + half, lda, b + half * ldb,
+                    ldb, stream);
+  }
+}
+
+// Replaces the rows x cols block x with y^T and the cols x rows block y with
+// x^T; both have row stride ld and they do not overlap.
+template <typename T>
+void SwapTransposed(const S21BasicKernels<T>& kernels, int rows, int cols,
+                    T* x, T* y, long ld) noexcept {
+  if (rows <= kLeaf && cols <= kLeaf) {
+    alignas(64) T tile[kLeaf * kLeaf];
+    kernels.transpose(rows, cols, x, ld, tile, rows, false);
+    kernels.transpose(cols, rows, y, ld, x, ld, false);
+    for (int i = 0; i < cols; ++i) {
+      std::memcpy(y + i * ld, tile + i * rows, sizeof(T) * rows);
+    }
+  } else if (rows >= cols) {
+    const int half = Split(rows);
+    SwapTransposed(kernels, half, cols, x, y, ld);
+    SwapTransposed(kernels, rows - half, cols, x + half * ld, y + half, ld);
+  } else {
+    const int half = Split(cols);
+    SwapTransposed(kernels, rows, half, x, y, ld);
+    SwapTransposed(kernels, rows, cols - half, x + half, y + half * ld, ld);
+  }
+}
+
+template <typename T>
+void TransposeSquare(const S21BasicKernels<T>& kernels, int n, T* a,
+                     long ld) noexcept {
+  if (n <= kLeaf) {
+    alignas(64) T tile[kLeaf * kLeaf];
+    kernels.transpose(n, n, a, ld, tile, n, false);
+    for (int i = 0; i < n; ++i) {
+      std::memcpy(a + i * ld, tile + i * n, sizeof(T) * n);
+    }
+  } else {
+    const int half = Split(n);
+    TransposeSquare(kernels, half, a, ld);
+    TransposeSquare(kernels, n - half, a + half * ld + half, ld);
+    SwapTransposed(kernels, half, n - half, a + half, a + half * ld, ld);
+  }
+}
+
+}  // namespace
+
+template <typename T>
+void S21Transpose(int rows, int cols, const T* a, long lda, T* b,
+                  long ldb) noexcept {
+  TransposeBlocks(S21ActiveKernels<T>(), rows, cols, a, lda, b, ldb,
+                  static_cast<long>(rows) * cols > kStreamSize);
+}
+
+template <typename T>
+void S21TransposeSquareInPlace(int n, T* a, long lda) noexcept {
+  TransposeSquare(S21ActiveKernels<T>(), n, a, lda);
+}
+
+template <typename T>
+void S21TransposeInPlace(int rows, int cols, T* a) {
+  if (rows == cols) {
+    S21TransposeSquareInPlace(rows, a, cols);
+  } else if (rows > 1 && cols > 1) {
+    // Element p = i * cols + j moves to j * rows + i. The first and last
+    // elements stay put; every other cycle is walked once, carrying one
+    // element along and marking the positions it fills.
+    const long size = static_cast<long>(rows) * cols;
+    const long words = (size + 63) / 64;
+    S21ArenaScope scratch;
+    std::uint64_t* visited = scratch.Allocate<std::uint64_t>(words);
+    std::fill(visited, visited + words, 0);
+    for (long start = 1; start < size - 1; ++start) {
+      if (!(visited[start / 64] >> (start % 64) & 1)) {
+        T carried = a[start];
+        long p = start;
+        do {
+          p = p % cols * rows + p / cols;
+          std::swap(carried, a[p]);
+          visited[p / 64] |= std::uint64_t{1} << (p % 64);
+        } while (p != start);
+      }
+    }
+  }
+}
+
+template void S21Transpose(int, int, const double*, long, double*,
+                           long) noexcept;
+template void S21Transpose(int, int, const float*, long, float*,
+                           long) noexcept;
+template void S21Transpose(int, int, const std::int64_t*, long,
+                           std::int64_t*, long) noexcept;
+template void S21TransposeSquareInPlace(int, double*, long) noexcept;
+template void S21TransposeSquareInPlace(int, float*, long) noexcept;
+template void S21TransposeSquareInPlace(int, std::int64_t*, long) noexcept;
+template void S21TransposeInPlace(int, int, double*);
+template void S21TransposeInPlace(int, int, float*);
+template void S21TransposeInPlace(int, int, std::int64_t*);
@@ -0,0 +1,28 @@
+#ifndef CPP_S21_MATRIXPLUS_SRC_S21_TRANSPOSE_H_
+#define CPP_S21_MATRIXPLUS_SRC_S21_TRANSPOSE_H_
+
+// Transposes on row-major storage. All of them split the matrix recursively
+// until a block pair fits in L1, so they stay cache and TLB friendly at any
+// size without tuning, and transpose the blocks with the vector kernel of
+// the active instruction set.
+
+// T is one of the element types with kernels in s21_simd.h: double, float
+// or std::int64_t.
+
+// B = A^T, where A is rows x cols with row stride lda and B is cols x rows
+// with row stride ldb. A and B must not overlap.
+template <typename T>
+void S21Transpose(int rows, int cols, const T* a, long lda, T* b,
+                  long ldb) noexcept;
+
+// A = A^T for an n x n matrix with row stride lda.
+template <typename T>
+void S21TransposeSquareInPlace(int n, T* a, long lda) noexcept;
+
+// Rearranges a contiguous rows x cols matrix into its cols x rows transpose
+// in the same buffer by following the cycles of the permutation. Needs a
+// bit per element of scratch space.
+template <typename T>
+void S21TransposeInPlace(int rows, int cols, T* a);
+
+#endif  // CPP_S21_MATRIXPLUS_SRC_S21_TRANSPOSE_H_